@@ -97,6 +97,37 @@ bool BlenderSync::object_is_light(BL::Object &b_ob)
 
 /* Object */
 
+const BlenderSync::ObjectSyncSettings &BlenderSync::object_sync_settings(BL::Object &b_ob)
+{
+  auto it = object_settings_cache.find(b_ob.ptr.data);
+  if (it != object_settings_cache.end()) {
+    return it->second;
+  }
+
+  ObjectSyncSettings &settings = object_settings_cache[b_ob.ptr.data];
+
+  PointerRNA cobject = RNA_pointer_get(&b_ob.ptr, "cycles");
+  settings.visibility = object_ray_visibility(b_ob);
+  settings.is_holdout = get_boolean(cobject, "is_holdout");
+  settings.is_shadow_catcher = get_boolean(cobject, "is_shadow_catcher");
+  settings.shadow_terminator_offset = get_float(cobject, "shadow_terminator_offset");
+  settings.name = b_ob.name().c_str();
+
+  /* The asset name for Cryptomatte is the name of the root parent. */
+  BL::Object parent = b_ob.parent();
+  if (parent) {
+    while (parent.parent()) {
+      parent = parent.parent();
+    }
+    settings.asset_name = parent.name();
+  }
+  else {
+    settings.asset_name = settings.name;
+  }
+
+  return settings;
+}
+
 Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
                                  BL::ViewLayer &b_view_layer,
                                  BL::DepsgraphObjectInstance &b_instance,
@@ -154,14 +185,16 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     return NULL;
   }
 
+  /* Instances share the settings of the object they instance, so look them up
+   * through the original object rather than the temporary instance copy. */
+  const ObjectSyncSettings &settings = object_sync_settings(b_ob_instance);
+
   /* Visibility flags for both parent and child. */
-  PointerRNA cobject = RNA_pointer_get(&b_ob.ptr, "cycles");
-  bool use_holdout = get_boolean(cobject, "is_holdout") ||
-                     b_parent.holdout_get(PointerRNA_NULL, b_view_layer);
-  uint visibility = object_ray_visibility(b_ob) & PATH_RAY_ALL_VISIBILITY;
+  bool use_holdout = settings.is_holdout || b_parent.holdout_get(PointerRNA_NULL, b_view_layer);
+  uint visibility = settings.visibility & PATH_RAY_ALL_VISIBILITY;
 
   if (b_parent.ptr.data != b_ob.ptr.data) {
-    visibility &= object_ray_visibility(b_parent);
+    visibility &= object_sync_settings(b_parent).visibility;
   }
 
   /* TODO: make holdout objects on excluded layer invisible for non-camera rays. */
@@ -246,32 +279,19 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     object_updated = true;
   }
 
-  bool is_shadow_catcher = get_boolean(cobject, "is_shadow_catcher");
-  if (is_shadow_catcher != object->is_shadow_catcher) {
-    object->is_shadow_catcher = is_shadow_catcher;
+  if (settings.is_shadow_catcher != object->is_shadow_catcher) {
+    object->is_shadow_catcher = settings.is_shadow_catcher;
     object_updated = true;
   }
 
-  float shadow_terminator_offset = get_float(cobject, "shadow_terminator_offset");
-  if (shadow_terminator_offset != object->shadow_terminator_offset) {
-    object->shadow_terminator_offset = shadow_terminator_offset;
+  if (settings.shadow_terminator_offset != object->shadow_terminator_offset) {
+    object->shadow_terminator_offset = settings.shadow_terminator_offset;
     object_updated = true;
   }
 
   /* sync the asset name for Cryptomatte */
-  BL::Object parent = b_ob.parent();
-  ustring parent_name;
-  if (parent) {
-    while (parent.parent()) {
-      parent = parent.parent();
-    }
-    parent_name = parent.name();
-  }
-  else {
-    parent_name = b_ob.name();
-  }
-  if (object->asset_name != parent_name) {
-    object->asset_name = parent_name;
+  if (object->asset_name != settings.asset_name) {
+    object->asset_name = settings.asset_name;
     object_updated = true;
   }
 
@@ -280,7 +300,7 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
    * in the depsgraph and may not signal changes, so this is a workaround */
   if (object_updated || (object->geometry && object->geometry->need_update) ||
       tfm != object->tfm) {
-    object->name = b_ob.name().c_str();
+    object->name = settings.name;
     object->pass_id = b_ob.pass_index();
     object->color = get_float3(b_ob.color());
     object->tfm = tfm;
@@ -367,6 +387,9 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
     geometry_motion_synced.clear();
   }
 
+  /* Object settings may have changed since the previous sync. */
+  object_settings_cache.clear();
+
   /* initialize culling */
   BlenderObjectCulling culling(scene, b_scene);
 
@@ -429,6 +452,8 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
 
   geom_task_pool.wait_work();
 
+  map_free_memory(object_settings_cache);
+
   progress.set_sync_status("");
 
   if (!cancel && !motion) {
@@ -139,6 +139,17 @@ class BlenderSync {
   void sync_nodes(Shader *shader, BL::ShaderNodeTree &b_ntree);
 
   /* Object */
+  struct ObjectSyncSettings {
+    uint visibility;
+    bool is_holdout;
+    bool is_shadow_catcher;
+    float shadow_terminator_offset;
+    ustring name;
+    ustring asset_name;
+  };
+
+  const ObjectSyncSettings &object_sync_settings(BL::Object &b_ob);
+
   Object *sync_object(BL::Depsgraph &b_depsgraph,
                       BL::ViewLayer &b_view_layer,
                       BL::DepsgraphObjectInstance &b_instance,
@@ -229,6 +240,9 @@ class BlenderSync {
   set<Geometry *> geometry_synced;
   set<Geometry *> geometry_motion_synced;
   set<float> motion_times;
+  /* Settings of objects read through RNA, cached for the duration of a single object
+   * sync so that instances of the same object only look them up once. */
+  unordered_map<void *, ObjectSyncSettings> object_settings_cache;
   void *world_map;
   bool world_recalc;
   BlenderViewportParameters viewport_parameters;
@@ -55,11 +55,14 @@ struct UpdateObjectTransformState {
    */
   map<ParticleSystem *, int> particle_offset;
 
-  /* Mesh area.
-   * Used to avoid calculation of mesh area multiple times. Used for both
-   * read and write. Acquire surface_area_lock to keep it all thread safe.
+  /* Prototype data.
+   * Data which only depends on the geometry is computed once per unique
+   * geometry before the objects are updated, so that instances sharing the
+   * same geometry only combine it with their own transform. Only used for read.
    */
-  map<Mesh *, float> surface_area_map;
+  array<int> object_prototype;
+  array<float> prototype_surface_area;
+  array<uint> prototype_flag;
 
   /* Motion offsets for each object. */
   array<uint> motion_offset;
@@ -79,9 +82,6 @@ struct UpdateObjectTransformState {
 
   Scene *scene;
 
-  /* Some locks to keep everything thread-safe. */
-  thread_spin_lock surface_area_lock;
-
   /* First unused object index in the queue. */
   int queue_start_object;
 };
@@ -367,10 +367,52 @@ ObjectManager::~ObjectManager()
 {
 }
 
+static float geometry_surface_area(Geometry *geom)
+{
+  if (geom->type != Geometry::MESH) {
+    return 0.0f;
+  }
+
+  Mesh *mesh = static_cast<Mesh *>(geom);
+  if (mesh->has_volume) {
+    return 0.0f;
+  }
+
+  float surface_area = 0.0f;
+  size_t num_triangles = mesh->num_triangles();
+  for (size_t j = 0; j < num_triangles; j++) {
+    Mesh::Triangle t = mesh->get_triangle(j);
+    float3 p1 = mesh->verts[t.v[0]];
+    float3 p2 = mesh->verts[t.v[1]];
+    float3 p3 = mesh->verts[t.v[2]];
+
+    surface_area += triangle_area(p1, p2, p3);
+  }
+
+  return surface_area;
+}
+
+static uint geometry_object_flag(Geometry *geom)
+{
+  uint flag = 0;
+
+  if (geom->type == Geometry::MESH) {
+    /* TODO: why only mesh? */
+    Mesh *mesh = static_cast<Mesh *>(geom);
+    if (mesh->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION)) {
+      flag |= SD_OBJECT_HAS_VERTEX_MOTION;
+    }
+  }
+
+  return flag;
+}
+
 static float object_surface_area(UpdateObjectTransformState *state,
                                  const Transform &tfm,
-                                 Geometry *geom)
+                                 Object *ob)
 {
+  Geometry *geom = ob->geometry;
+
   if (geom->type != Geometry::MESH && geom->type != Geometry::VOLUME) {
     return 0.0f;
   }
@@ -392,51 +434,21 @@ static float object_surface_area(UpdateObjectTransformState *state,
    *
    * TODO(brecht): Correct for displacement, and move to a better place.
    */
-  float surface_area = 0.0f;
   float uniform_scale;
   if (transform_uniform_scale(tfm, uniform_scale)) {
-    map<Mesh *, float>::iterator it;
-
-    /* NOTE: This isn't fully optimal and could in theory lead to multiple
-     * threads calculating area of the same mesh in parallel. However, this
-     * also prevents suspending all the threads when some mesh's area is
-     * not yet known.
-     */
-    state->surface_area_lock.lock();
-    it = state->surface_area_map.find(mesh);
-    state->surface_area_lock.unlock();
-
-    if (it == state->surface_area_map.end()) {
-      size_t num_triangles = mesh->num_triangles();
-      for (size_t j = 0; j < num_triangles; j++) {
-        Mesh::Triangle t = mesh->get_triangle(j);
-        float3 p1 = mesh->verts[t.v[0]];
-        float3 p2 = mesh->verts[t.v[1]];
-        float3 p3 = mesh->verts[t.v[2]];
-
-        surface_area += triangle_area(p1, p2, p3);
-      }
-
-      state->surface_area_lock.lock();
-      state->surface_area_map[mesh] = surface_area;
-      state->surface_area_lock.unlock();
-    }
-    else {
-      surface_area = it->second;
-    }
-
-    surface_area *= uniform_scale;
+    const int prototype = state->object_prototype[ob->index];
+    return state->prototype_surface_area[prototype] * uniform_scale;
   }
-  else {
-    size_t num_triangles = mesh->num_triangles();
-    for (size_t j = 0; j < num_triangles; j++) {
-      Mesh::Triangle t = mesh->get_triangle(j);
-      float3 p1 = transform_point(&tfm, mesh->verts[t.v[0]]);
-      float3 p2 = transform_point(&tfm, mesh->verts[t.v[1]]);
-      float3 p3 = transform_point(&tfm, mesh->verts[t.v[2]]);
 
-      surface_area += triangle_area(p1, p2, p3);
-    }
+  float surface_area = 0.0f;
+  size_t num_triangles = mesh->num_triangles();
+  for (size_t j = 0; j < num_triangles; j++) {
+    Mesh::Triangle t = mesh->get_triangle(j);
+    float3 p1 = transform_point(&tfm, mesh->verts[t.v[0]]);
+    float3 p2 = transform_point(&tfm, mesh->verts[t.v[1]]);
+    float3 p3 = transform_point(&tfm, mesh->verts[t.v[2]]);
+
+    surface_area += triangle_area(p1, p2, p3);
   }
 
   return surface_area;
@@ -448,7 +460,7 @@ void ObjectManager::device_update_object_transform(UpdateObjectTransformState *s
   Transform *object_motion_pass = state->object_motion_pass;
 
   Geometry *geom = ob->geometry;
-  uint flag = 0;
+  uint flag = state->prototype_flag[state->object_prototype[ob->index]];
 
   /* Compute transformations. */
   Transform tfm = ob->tfm;
@@ -463,7 +475,7 @@ void ObjectManager::device_update_object_transform(UpdateObjectTransformState *s
 
   kobject.tfm = tfm;
   kobject.itfm = itfm;
-  kobject.surface_area = object_surface_area(state, tfm, geom);
+  kobject.surface_area = object_surface_area(state, tfm, ob);
   kobject.color[0] = color.x;
   kobject.color[1] = color.y;
   kobject.color[2] = color.z;
@@ -476,14 +488,6 @@ void ObjectManager::device_update_object_transform(UpdateObjectTransformState *s
     state->have_motion = true;
   }
 
-  if (geom->type == Geometry::MESH) {
-    /* TODO: why only mesh? */
-    Mesh *mesh = static_cast<Mesh *>(geom);
-    if (mesh->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION)) {
-      flag |= SD_OBJECT_HAS_VERTEX_MOTION;
-    }
-  }
-
   if (state->need_motion == Scene::MOTION_PASS) {
     /* Clear motion array if there is no actual motion. */
     ob->update_motion();
@@ -602,6 +606,34 @@ void ObjectManager::device_update_transforms(DeviceScene *dscene, Scene *scene,
     numparticles += psys->particles.size();
   }
 
+  /* Gather unique geometries, so that data shared by all instances of the same
+   * geometry is computed once per prototype rather than once per object. */
+  vector<Geometry *> prototypes;
+  {
+    unordered_map<Geometry *, int> prototype_map;
+    int *object_prototype = state.object_prototype.resize(scene->objects.size());
+
+    foreach (Object *ob, scene->objects) {
+      auto it = prototype_map.find(ob->geometry);
+      if (it == prototype_map.end()) {
+        it = prototype_map.emplace(ob->geometry, (int)prototypes.size()).first;
+        prototypes.push_back(ob->geometry);
+      }
+      *object_prototype = it->second;
+      object_prototype++;
+    }
+  }
+
+  state.prototype_surface_area.resize(prototypes.size());
+  state.prototype_flag.resize(prototypes.size());
+
+  parallel_for(blocked_range<size_t>(0, prototypes.size()), [&](const blocked_range<size_t> &r) {
+    for (size_t i = r.begin(); i != r.end(); i++) {
+      state.prototype_surface_area[i] = geometry_surface_area(prototypes[i]);
+      state.prototype_flag[i] = geometry_object_flag(prototypes[i]);
+    }
+  });
+
   /* Parallel object update, with grain size to avoid too much threading overhead
    * for individual objects. */
   static const int OBJECTS_PER_TASK = 32;
@@ -229,6 +229,10 @@ void MEM_enable_fail_on_memleak(void);
 /* Switch allocator to slower but fully guarded mode. */
 void MEM_use_guarded_allocator(void);
 
+/* Switch allocator to use per-thread caches for small blocks,
+ * must be called before any allocation happened. */
+void MEM_use_thread_cache_allocator(void);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
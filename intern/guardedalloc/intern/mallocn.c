@@ -123,3 +123,34 @@ void MEM_use_guarded_allocator(void)
   MEM_name_ptr = MEM_guarded_name_ptr;
 #endif
 }
+
+void MEM_use_thread_cache_allocator(void)
+{
+  MEM_thread_cache_init();
+
+  MEM_allocN_len = MEM_thread_cache_allocN_len;
+  MEM_freeN = MEM_thread_cache_freeN;
+  MEM_dupallocN = MEM_thread_cache_dupallocN;
+  MEM_reallocN_id = MEM_thread_cache_reallocN_id;
+  MEM_recallocN_id = MEM_thread_cache_recallocN_id;
+  MEM_callocN = MEM_thread_cache_callocN;
+  MEM_calloc_arrayN = MEM_thread_cache_calloc_arrayN;
+  MEM_mallocN = MEM_thread_cache_mallocN;
+  MEM_malloc_arrayN = MEM_thread_cache_malloc_arrayN;
+  MEM_mallocN_aligned = MEM_thread_cache_mallocN_aligned;
+  MEM_printmemlist_pydict = MEM_thread_cache_printmemlist_pydict;
+  MEM_printmemlist = MEM_thread_cache_printmemlist;
+  MEM_callbackmemlist = MEM_thread_cache_callbackmemlist;
+  MEM_printmemlist_stats = MEM_thread_cache_printmemlist_stats;
+  MEM_set_error_callback = MEM_thread_cache_set_error_callback;
+  MEM_consistency_check = MEM_thread_cache_consistency_check;
+  MEM_set_memory_debug = MEM_thread_cache_set_memory_debug;
+  MEM_get_memory_in_use = MEM_thread_cache_get_memory_in_use;
+  MEM_get_memory_blocks_in_use = MEM_thread_cache_get_memory_blocks_in_use;
+  MEM_reset_peak_memory = MEM_thread_cache_reset_peak_memory;
+  MEM_get_peak_memory = MEM_thread_cache_get_peak_memory;
+
+#ifndef NDEBUG
+  MEM_name_ptr = MEM_thread_cache_name_ptr;
+#endif
+}
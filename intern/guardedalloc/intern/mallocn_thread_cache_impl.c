@@ -0,0 +1,922 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup MEM
+ *
+ * Memory allocation with per-thread caches of small blocks.
+ *
+ * Small blocks are served from per-thread free lists of fixed size classes, which are refilled
+ * in batches from a central heap carving blocks out of large pages. Only the central heap is
+ * shared between threads, so the common allocation and free paths don't use any atomic
+ * operation. Large and aligned blocks are allocated by the system allocator directly.
+ *
+ * The memory in use is a global atomic total so the peak stays exact, block counts are kept in
+ * per-thread counters which are merged when queried.
+ *
+ * When a thread exits, the blocks in its cache are given back to the central heap and the cache
+ * is reused by the next thread which starts allocating.
+ *
+ * \note Pages are never returned to the system.
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h> /* memcpy */
+#include <sys/types.h>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+#include "MEM_guardedalloc.h"
+
+/* to ensure strict conversions */
+#include "../../source/blender/blenlib/BLI_strict_flags.h"
+
+#include "atomic_ops.h"
+#include "mallocn_intern.h"
+
+typedef struct MemHead {
+  /* Length of allocated memory block. */
+  size_t len;
+} MemHead;
+
+typedef struct MemHeadAligned {
+  short alignment;
+  size_t len;
+} MemHeadAligned;
+
+enum {
+  MEMHEAD_ALIGN_FLAG = 1,
+  /* Block belongs to a size class and is recycled through the thread caches. */
+  MEMHEAD_CACHED_FLAG = 2,
+};
+
+#define MEMHEAD_FLAGS ((size_t)(MEMHEAD_ALIGN_FLAG | MEMHEAD_CACHED_FLAG))
+
+#define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
+#define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
+#define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
+#define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
+#define MEMHEAD_IS_CACHED(memhead) ((memhead)->len & (size_t)MEMHEAD_CACHED_FLAG)
+
+#ifdef _MSC_VER
+#  define MEM_THREAD_LOCAL __declspec(thread)
+#else
+#  define MEM_THREAD_LOCAL __thread
+#endif
+
+/* -------------------------------------------------------------------- */
+/** \name Size Classes
+ *
+ * Block sizes (including the #MemHead) use a 16 byte step up to 256 bytes,
+ * then four classes per power of two up to #SIZE_CLASS_MAX.
+ * \{ */
+
+#define SIZE_CLASS_NUM 32
+#define SIZE_CLASS_MAX 4096
+#define SIZE_CLASS_LOOKUP_SHIFT 4
+
+/* Size of the pages the central heap carves blocks from. */
+#define PAGE_SIZE (64 * 1024)
+/* Bytes moved at once between a thread cache and the central heap. */
+#define BATCH_BYTES (16 * 1024)
+/* Free bytes a thread cache may hold over all its size classes. */
+#define THREAD_CACHE_MAX_BYTES (256 * 1024)
+
+static const unsigned int size_class_size[SIZE_CLASS_NUM] = {
+    16,  32,  48,  64,  80,  96,   112,  128,  144,  160,  176,  192,  208,  224,  240,  256,
+    320, 384, 448, 512, 640, 768, 896, 1024, 1280, 1536, 1792, 2048, 2560, 3072, 3584, 4096,
+};
+
+static unsigned char size_class_lookup[SIZE_CLASS_MAX >> SIZE_CLASS_LOOKUP_SHIFT];
+
+static void size_class_lookup_init(void)
+{
+  unsigned int size_class = 0;
+  for (unsigned int i = 0; i < (SIZE_CLASS_MAX >> SIZE_CLASS_LOOKUP_SHIFT); i++) {
+    const unsigned int size = (i + 1) << SIZE_CLASS_LOOKUP_SHIFT;
+    while (size_class_size[size_class] < size) {
+      size_class++;
+    }
+    size_class_lookup[i] = (unsigned char)size_class;
+  }
+}
+
+/* Size includes the #MemHead, must be in the (0, #SIZE_CLASS_MAX] range. */
+MEM_INLINE unsigned int size_class_index(size_t size)
+{
+  return size_class_lookup[(size - 1) >> SIZE_CLASS_LOOKUP_SHIFT];
+}
+
+MEM_INLINE unsigned int size_class_batch(unsigned int size_class)
+{
+  const unsigned int batch = BATCH_BYTES / size_class_size[size_class];
+  return batch < 4 ? 4 : (batch > 64 ? 64 : batch);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Central Heap
+ * \{ */
+
+typedef struct FreeBlock {
+  struct FreeBlock *next;
+} FreeBlock;
+
+typedef struct CentralFreeList {
+  uint32_t lock;
+  unsigned int count;
+  FreeBlock *head;
+  /* Avoid false sharing between the locks of neighboring size classes. */
+  char _pad[64 - sizeof(uint32_t) - sizeof(unsigned int) - sizeof(FreeBlock *)];
+} CentralFreeList;
+
+static CentralFreeList central_heap[SIZE_CLASS_NUM];
+
+/* Spins before giving the time slice of a waiting thread away. */
+#define CENTRAL_LOCK_SPIN_MAX 64
+
+MEM_INLINE void cpu_relax(void)
+{
+#if defined(_MSC_VER)
+  YieldProcessor();
+#elif defined(__i386__) || defined(__x86_64__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+MEM_INLINE void thread_yield(void)
+{
+#ifdef _WIN32
+  SwitchToThread();
+#else
+  sched_yield();
+#endif
+}
+
+MEM_INLINE void central_lock(CentralFreeList *list)
+{
+  unsigned int spin = 0;
+  while (atomic_cas_uint32(&list->lock, 0, 1) != 0) {
+    /* Wait for the lock to look free before trying again, so waiting threads don't keep
+     * stealing the cache line from the owner. */
+    while (*(volatile uint32_t *)&list->lock != 0) {
+      if (spin < CENTRAL_LOCK_SPIN_MAX) {
+        cpu_relax();
+        spin++;
+      }
+      else {
+        thread_yield();
+      }
+    }
+  }
+}
+
+MEM_INLINE void central_unlock(CentralFreeList *list)
+{
+  atomic_cas_uint32(&list->lock, 1, 0);
+}
+
+/* Take up to `count` blocks from the central heap, allocating a new page when it's empty.
+ * Returns the number of blocks linked in `r_head`. */
+static unsigned int central_fetch(unsigned int size_class, unsigned int count, FreeBlock **r_head)
+{
+  CentralFreeList *list = &central_heap[size_class];
+  FreeBlock *head = NULL;
+  unsigned int fetched = 0;
+
+  central_lock(list);
+  while (fetched < count && list->head) {
+    FreeBlock *block = list->head;
+    list->head = block->next;
+    block->next = head;
+    head = block;
+    fetched++;
+  }
+  list->count -= fetched;
+  central_unlock(list);
+
+  if (fetched == 0) {
+    const size_t block_size = size_class_size[size_class];
+    char *page = (char *)malloc(PAGE_SIZE);
+    if (UNLIKELY(page == NULL)) {
+      *r_head = NULL;
+      return 0;
+    }
+
+    const unsigned int page_blocks = (unsigned int)(PAGE_SIZE / block_size);
+    FreeBlock *rest = NULL;
+    unsigned int rest_count = 0;
+    for (unsigned int i = 0; i < page_blocks; i++) {
+      FreeBlock *block = (FreeBlock *)(page + i * block_size);
+      if (fetched < count) {
+        block->next = head;
+        head = block;
+        fetched++;
+      }
+      else {
+        block->next = rest;
+        rest = block;
+        rest_count++;
+      }
+    }
+
+    if (rest) {
+      /* Find the tail to splice the remainder of the page into the central list. */
+      FreeBlock *tail = rest;
+      while (tail->next) {
+        tail = tail->next;
+      }
+      central_lock(list);
+      tail->next = list->head;
+      list->head = rest;
+      list->count += rest_count;
+      central_unlock(list);
+    }
+  }
+
+  *r_head = head;
+  return fetched;
+}
+
+static void central_release(unsigned int size_class,
+                            FreeBlock *head,
+                            FreeBlock *tail,
+                            unsigned int count)
+{
+  CentralFreeList *list = &central_heap[size_class];
+
+  central_lock(list);
+  tail->next = list->head;
+  list->head = head;
+  list->count += count;
+  central_unlock(list);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Thread Caches
+ * \{ */
+
+typedef struct ThreadFreeList {
+  FreeBlock *head;
+  unsigned int count;
+} ThreadFreeList;
+
+typedef struct ThreadCache {
+  struct ThreadCache *next;
+  /* Set while a thread uses this cache. */
+  uint32_t owned;
+  ThreadFreeList lists[SIZE_CLASS_NUM];
+  /* Size of all the blocks in the free lists. */
+  size_t free_bytes;
+
+  /* Only written by the owning thread, read by others through #counter_load. Signed since
+   * blocks may be freed by a different thread than the one which allocated them. */
+  int64_t totblock;
+} ThreadCache;
+
+/* All thread caches ever created, never freed so statistics of finished threads are kept.
+ * Caches of finished threads are reused by new threads. */
+static ThreadCache *thread_caches = NULL;
+static MEM_THREAD_LOCAL ThreadCache *thread_cache = NULL;
+
+/* Calls #thread_cache_exit when a thread which has a cache exits. */
+#ifdef _WIN32
+static DWORD thread_cache_key = FLS_OUT_OF_INDEXES;
+#else
+static pthread_key_t thread_cache_key;
+#endif
+static uint32_t thread_cache_key_created = 0;
+
+static size_t mem_in_use = 0, peak_mem = 0;
+static bool malloc_debug_memset = false;
+
+static void (*error_callback)(const char *) = NULL;
+
+/* Relaxed accesses for the per-thread counters, the owning thread is the only writer so no
+ * read-modify-write is needed, other threads only need to see untorn values. */
+MEM_INLINE int64_t counter_load(const int64_t *p)
+{
+#ifdef _MSC_VER
+  return *(const volatile int64_t *)p;
+#else
+  return __atomic_load_n(p, __ATOMIC_RELAXED);
+#endif
+}
+
+MEM_INLINE void counter_add(int64_t *p, int64_t x)
+{
+#ifdef _MSC_VER
+  *(volatile int64_t *)p = *p + x;
+#else
+  __atomic_store_n(p, *p + x, __ATOMIC_RELAXED);
+#endif
+}
+
+MEM_INLINE void mem_in_use_add(size_t len)
+{
+  atomic_fetch_and_update_max_z(&peak_mem, atomic_add_and_fetch_z(&mem_in_use, len));
+}
+
+/* Give the first `count` blocks of the list back to the central heap. */
+static void thread_list_release(ThreadCache *cache, unsigned int size_class, unsigned int count)
+{
+  ThreadFreeList *list = &cache->lists[size_class];
+  FreeBlock *head = list->head, *tail = head;
+  for (unsigned int i = 1; i < count; i++) {
+    tail = tail->next;
+  }
+  list->head = tail->next;
+  list->count -= count;
+  cache->free_bytes -= (size_t)count * size_class_size[size_class];
+  central_release(size_class, head, tail, count);
+}
+
+/* Above the limit of the whole cache, give back half of every size class. */
+static void thread_cache_shrink(ThreadCache *cache)
+{
+  for (unsigned int i = 0; i < SIZE_CLASS_NUM; i++) {
+    if (cache->lists[i].count > 1) {
+      thread_list_release(cache, i, cache->lists[i].count / 2);
+    }
+  }
+}
+
+static void thread_cache_flush(ThreadCache *cache)
+{
+  for (unsigned int i = 0; i < SIZE_CLASS_NUM; i++) {
+    if (cache->lists[i].count) {
+      thread_list_release(cache, i, cache->lists[i].count);
+    }
+  }
+}
+
+#ifdef _WIN32
+static void WINAPI thread_cache_exit(void *data)
+#else
+static void thread_cache_exit(void *data)
+#endif
+{
+  ThreadCache *cache = (ThreadCache *)data;
+  thread_cache_flush(cache);
+  /* Destructors running after this one may still allocate, they get a cache again and this
+   * destructor is called for it once more. */
+  thread_cache = NULL;
+  atomic_cas_uint32(&cache->owned, 1, 0);
+}
+
+static void thread_cache_key_create(void)
+{
+  if (atomic_cas_uint32(&thread_cache_key_created, 0, 1) != 0) {
+    return;
+  }
+#ifdef _WIN32
+  thread_cache_key = FlsAlloc(thread_cache_exit);
+#else
+  pthread_key_create(&thread_cache_key, thread_cache_exit);
+#endif
+}
+
+static ThreadCache *thread_cache_create(void)
+{
+  ThreadCache *cache = NULL;
+
+  /* Reuse the cache of a thread which exited. */
+  for (ThreadCache *iter = thread_caches; iter; iter = iter->next) {
+    if (iter->owned == 0 && atomic_cas_uint32(&iter->owned, 0, 1) == 0) {
+      cache = iter;
+      break;
+    }
+  }
+
+  if (cache == NULL) {
+    cache = (ThreadCache *)calloc(1, sizeof(ThreadCache));
+    if (UNLIKELY(cache == NULL)) {
+      abort();
+    }
+    cache->owned = 1;
+
+    void *head;
+    do {
+      head = thread_caches;
+      cache->next = (ThreadCache *)head;
+    } while (atomic_cas_ptr((void **)&thread_caches, head, cache) != head);
+  }
+
+#ifdef _WIN32
+  FlsSetValue(thread_cache_key, cache);
+#else
+  pthread_setspecific(thread_cache_key, cache);
+#endif
+
+  return cache;
+}
+
+MEM_INLINE ThreadCache *thread_cache_get(void)
+{
+  ThreadCache *cache = thread_cache;
+  if (UNLIKELY(cache == NULL)) {
+    cache = thread_cache = thread_cache_create();
+  }
+  return cache;
+}
+
+static unsigned int totblock_merge(void)
+{
+  int64_t totblock = 0;
+  for (ThreadCache *cache = thread_caches; cache; cache = cache->next) {
+    totblock += counter_load(&cache->totblock);
+  }
+  return totblock > 0 ? (unsigned int)totblock : 0;
+}
+
+static MemHead *thread_cache_alloc(ThreadCache *cache, unsigned int size_class)
+{
+  ThreadFreeList *list = &cache->lists[size_class];
+
+  if (UNLIKELY(list->head == NULL)) {
+    list->count = central_fetch(size_class, size_class_batch(size_class), &list->head);
+    if (UNLIKELY(list->head == NULL)) {
+      return NULL;
+    }
+    cache->free_bytes += (size_t)list->count * size_class_size[size_class];
+    if (UNLIKELY(cache->free_bytes > THREAD_CACHE_MAX_BYTES)) {
+      thread_cache_shrink(cache);
+    }
+  }
+
+  FreeBlock *block = list->head;
+  list->head = block->next;
+  list->count--;
+  cache->free_bytes -= size_class_size[size_class];
+  return (MemHead *)block;
+}
+
+static void thread_cache_free(ThreadCache *cache, MemHead *memh, unsigned int size_class)
+{
+  ThreadFreeList *list = &cache->lists[size_class];
+  FreeBlock *block = (FreeBlock *)memh;
+
+  block->next = list->head;
+  list->head = block;
+  list->count++;
+  cache->free_bytes += size_class_size[size_class];
+
+  /* Give a batch back to the central heap so memory freed by one thread can be reused by
+   * others, and caches of idle threads don't grow unbounded. */
+  const unsigned int batch = size_class_batch(size_class);
+  if (UNLIKELY(list->count > batch * 2)) {
+    thread_list_release(cache, size_class, batch);
+  }
+  if (UNLIKELY(cache->free_bytes > THREAD_CACHE_MAX_BYTES)) {
+    thread_cache_shrink(cache);
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Allocator API
+ * \{ */
+
+#ifdef __GNUC__
+__attribute__((format(printf, 1, 2)))
+#endif
+static void
+print_error(const char *str, ...)
+{
+  char buf[512];
+  va_list ap;
+
+  va_start(ap, str);
+  vsnprintf(buf, sizeof(buf), str, ap);
+  va_end(ap);
+  buf[sizeof(buf) - 1] = '\0';
+
+  if (error_callback) {
+    error_callback(buf);
+  }
+}
+
+void MEM_thread_cache_init(void)
+{
+  size_class_lookup_init();
+  thread_cache_key_create();
+}
+
+size_t MEM_thread_cache_allocN_len(const void *vmemh)
+{
+  if (vmemh) {
+    return MEMHEAD_FROM_PTR(vmemh)->len & ~MEMHEAD_FLAGS;
+  }
+
+  return 0;
+}
+
+void MEM_thread_cache_freeN(void *vmemh)
+{
+  if (leak_detector_has_run) {
+    print_error("%s\n", free_after_leak_detection_message);
+  }
+
+  MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
+  size_t len = MEM_thread_cache_allocN_len(vmemh);
+
+  if (vmemh == NULL) {
+    print_error("Attempt to free NULL pointer\n");
+#ifdef WITH_ASSERT_ABORT
+    abort();
+#endif
+    return;
+  }
+
+  ThreadCache *cache = thread_cache_get();
+  counter_add(&cache->totblock, -1);
+  atomic_sub_and_fetch_z(&mem_in_use, len);
+
+  if (UNLIKELY(malloc_debug_memset && len)) {
+    memset(memh + 1, 255, len);
+  }
+  if (LIKELY(MEMHEAD_IS_CACHED(memh))) {
+    thread_cache_free(cache, memh, size_class_index(len + sizeof(MemHead)));
+  }
+  else if (UNLIKELY(MEMHEAD_IS_ALIGNED(memh))) {
+    MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
+    aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
+  }
+  else {
+    free(memh);
+  }
+}
+
+void *MEM_thread_cache_dupallocN(const void *vmemh)
+{
+  void *newp = NULL;
+  if (vmemh) {
+    MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
+    const size_t prev_size = MEM_thread_cache_allocN_len(vmemh);
+    if (UNLIKELY(MEMHEAD_IS_ALIGNED(memh))) {
+      MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
+      newp = MEM_thread_cache_mallocN_aligned(
+          prev_size, (size_t)memh_aligned->alignment, "dupli_malloc");
+    }
+    else {
+      newp = MEM_thread_cache_mallocN(prev_size, "dupli_malloc");
+    }
+    memcpy(newp, vmemh, prev_size);
+  }
+  return newp;
+}
+
+void *MEM_thread_cache_reallocN_id(void *vmemh, size_t len, const char *str)
+{
+  void *newp = NULL;
+
+  if (vmemh) {
+    MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
+    size_t old_len = MEM_thread_cache_allocN_len(vmemh);
+
+    if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
+      newp = MEM_thread_cache_mallocN(len, "realloc");
+    }
+    else {
+      MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
+      newp = MEM_thread_cache_mallocN_aligned(len, (size_t)memh_aligned->alignment, "realloc");
+    }
+
+    if (newp) {
+      if (len < old_len) {
+        /* shrink */
+        memcpy(newp, vmemh, len);
+      }
+      else {
+        /* grow (or remain same size) */
+        memcpy(newp, vmemh, old_len);
+      }
+    }
+
+    MEM_thread_cache_freeN(vmemh);
+  }
+  else {
+    newp = MEM_thread_cache_mallocN(len, str);
+  }
+
+  return newp;
+}
+
+void *MEM_thread_cache_recallocN_id(void *vmemh, size_t len, const char *str)
+{
+  void *newp = NULL;
+
+  if (vmemh) {
+    MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
+    size_t old_len = MEM_thread_cache_allocN_len(vmemh);
+
+    if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
+      newp = MEM_thread_cache_mallocN(len, "recalloc");
+    }
+    else {
+      MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
+      newp = MEM_thread_cache_mallocN_aligned(len, (size_t)memh_aligned->alignment, "recalloc");
+    }
+
+    if (newp) {
+      if (len < old_len) {
+        /* shrink */
+        memcpy(newp, vmemh, len);
+      }
+      else {
+        memcpy(newp, vmemh, old_len);
+
+        if (len > old_len) {
+          /* grow */
+          /* zero new bytes */
+          memset(((char *)newp) + old_len, 0, len - old_len);
+        }
+      }
+    }
+
+    MEM_thread_cache_freeN(vmemh);
+  }
+  else {
+    newp = MEM_thread_cache_callocN(len, str);
+  }
+
+  return newp;
+}
+
+/* Allocate a block with room for `len` bytes after the #MemHead, from the thread cache when
+ * it fits in a size class. The returned header is not initialized. */
+MEM_INLINE MemHead *thread_cache_memh_alloc(ThreadCache *cache, size_t len, bool clear)
+{
+  const size_t size = len + sizeof(MemHead);
+  MemHead *memh;
+
+  if (LIKELY(size <= SIZE_CLASS_MAX)) {
+    memh = thread_cache_alloc(cache, size_class_index(size));
+    if (LIKELY(memh)) {
+      if (clear) {
+        memset(memh + 1, 0, len);
+      }
+      memh->len = len | (size_t)MEMHEAD_CACHED_FLAG;
+    }
+  }
+  else {
+    memh = (MemHead *)(clear ? calloc(1, size) : malloc(size));
+    if (LIKELY(memh)) {
+      memh->len = len;
+    }
+  }
+
+  return memh;
+}
+
+void *MEM_thread_cache_callocN(size_t len, const char *str)
+{
+  ThreadCache *cache = thread_cache_get();
+  MemHead *memh;
+
+  len = SIZET_ALIGN_4(len);
+
+  memh = thread_cache_memh_alloc(cache, len, true);
+
+  if (LIKELY(memh)) {
+    counter_add(&cache->totblock, 1);
+    mem_in_use_add(len);
+
+    return PTR_FROM_MEMHEAD(memh);
+  }
+  print_error("Calloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
+              SIZET_ARG(len),
+              str,
+              (unsigned int)MEM_thread_cache_get_memory_in_use());
+  return NULL;
+}
+
+void *MEM_thread_cache_calloc_arrayN(size_t len, size_t size, const char *str)
+{
+  size_t total_size;
+  if (UNLIKELY(!MEM_size_safe_multiply(len, size, &total_size))) {
+    print_error(
+        "Calloc array aborted due to integer overflow: "
+        "len=" SIZET_FORMAT "x" SIZET_FORMAT " in %s, total %u\n",
+        SIZET_ARG(len),
+        SIZET_ARG(size),
+        str,
+        (unsigned int)MEM_thread_cache_get_memory_in_use());
+    abort();
+    return NULL;
+  }
+
+  return MEM_thread_cache_callocN(total_size, str);
+}
+
+void *MEM_thread_cache_mallocN(size_t len, const char *str)
+{
+  ThreadCache *cache = thread_cache_get();
+  MemHead *memh;
+
+  len = SIZET_ALIGN_4(len);
+
+  memh = thread_cache_memh_alloc(cache, len, false);
+
+  if (LIKELY(memh)) {
+    if (UNLIKELY(malloc_debug_memset && len)) {
+      memset(memh + 1, 255, len);
+    }
+
+    counter_add(&cache->totblock, 1);
+    mem_in_use_add(len);
+
+    return PTR_FROM_MEMHEAD(memh);
+  }
+  print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
+              SIZET_ARG(len),
+              str,
+              (unsigned int)MEM_thread_cache_get_memory_in_use());
+  return NULL;
+}
+
+void *MEM_thread_cache_malloc_arrayN(size_t len, size_t size, const char *str)
+{
+  size_t total_size;
+  if (UNLIKELY(!MEM_size_safe_multiply(len, size, &total_size))) {
+    print_error(
+        "Malloc array aborted due to integer overflow: "
+        "len=" SIZET_FORMAT "x" SIZET_FORMAT " in %s, total %u\n",
+        SIZET_ARG(len),
+        SIZET_ARG(size),
+        str,
+        (unsigned int)MEM_thread_cache_get_memory_in_use());
+    abort();
+    return NULL;
+  }
+
+  return MEM_thread_cache_mallocN(total_size, str);
+}
+
+void *MEM_thread_cache_mallocN_aligned(size_t len, size_t alignment, const char *str)
+{
+  /* Huge alignment values doesn't make sense and they wouldn't fit into 'short' used in the
+   * MemHead. */
+  assert(alignment < 1024);
+
+  /* We only support alignments that are a power of two. */
+  assert(IS_POW2(alignment));
+
+  /* Some OS specific aligned allocators require a certain minimal alignment. */
+  if (alignment < ALIGNED_MALLOC_MINIMUM_ALIGNMENT) {
+    alignment = ALIGNED_MALLOC_MINIMUM_ALIGNMENT;
+  }
+
+  /* It's possible that MemHead's size is not properly aligned,
+   * do extra padding to deal with this.
+   *
+   * We only support small alignments which fits into short in
+   * order to save some bits in MemHead structure.
+   */
+  size_t extra_padding = MEMHEAD_ALIGN_PADDING(alignment);
+
+  len = SIZET_ALIGN_4(len);
+
+  MemHeadAligned *memh = (MemHeadAligned *)aligned_malloc(
+      len + extra_padding + sizeof(MemHeadAligned), alignment);
+
+  if (LIKELY(memh)) {
+    /* We keep padding in the beginning of MemHead,
+     * this way it's always possible to get MemHead
+     * from the data pointer.
+     */
+    memh = (MemHeadAligned *)((char *)memh + extra_padding);
+
+    if (UNLIKELY(malloc_debug_memset && len)) {
+      memset(memh + 1, 255, len);
+    }
+
+    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
+    memh->alignment = (short)alignment;
+
+    ThreadCache *cache = thread_cache_get();
+    counter_add(&cache->totblock, 1);
+    mem_in_use_add(len);
+
+    return PTR_FROM_MEMHEAD(memh);
+  }
+  print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
+              SIZET_ARG(len),
+              str,
+              (unsigned int)MEM_thread_cache_get_memory_in_use());
+  return NULL;
+}
+
+void MEM_thread_cache_printmemlist_pydict(void)
+{
+}
+
+void MEM_thread_cache_printmemlist(void)
+{
+}
+
+/* unused */
+void MEM_thread_cache_callbackmemlist(void (*func)(void *))
+{
+  (void)func; /* Ignored. */
+}
+
+void MEM_thread_cache_printmemlist_stats(void)
+{
+  size_t cached_mem = 0;
+  for (unsigned int i = 0; i < SIZE_CLASS_NUM; i++) {
+    cached_mem += (size_t)central_heap[i].count * size_class_size[i];
+  }
+  for (ThreadCache *cache = thread_caches; cache; cache = cache->next) {
+    for (unsigned int i = 0; i < SIZE_CLASS_NUM; i++) {
+      cached_mem += (size_t)cache->lists[i].count * size_class_size[i];
+    }
+  }
+
+  printf("\ntotal memory len: %.3f MB\n",
+         (double)mem_in_use / (double)(1024 * 1024));
+  printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
+  printf("cached free memory len: %.3f MB\n", (double)cached_mem / (double)(1024 * 1024));
+  printf(
+      "\nFor more detailed per-block statistics run Blender with memory debugging command line "
+      "argument.\n");
+
+#ifdef HAVE_MALLOC_STATS
+  printf("System Statistics:\n");
+  malloc_stats();
+#endif
+}
+
+void MEM_thread_cache_set_error_callback(void (*func)(const char *))
+{
+  error_callback = func;
+}
+
+bool MEM_thread_cache_consistency_check(void)
+{
+  return true;
+}
+
+void MEM_thread_cache_set_memory_debug(void)
+{
+  malloc_debug_memset = true;
+}
+
+size_t MEM_thread_cache_get_memory_in_use(void)
+{
+  return mem_in_use;
+}
+
+unsigned int MEM_thread_cache_get_memory_blocks_in_use(void)
+{
+  return totblock_merge();
+}
+
+void MEM_thread_cache_reset_peak_memory(void)
+{
+  peak_mem = mem_in_use;
+}
+
+size_t MEM_thread_cache_get_peak_memory(void)
+{
+  return peak_mem;
+}
+
+#ifndef NDEBUG
+const char *MEM_thread_cache_name_ptr(void *vmemh)
+{
+  if (vmemh) {
+    return "unknown block name ptr";
+  }
+
+  return "MEM_thread_cache_name_ptr(NULL)";
+}
+#endif /* NDEBUG */
+
+/** \} */
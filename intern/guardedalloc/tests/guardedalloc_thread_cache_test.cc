@@ -0,0 +1,131 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "BLI_utildefines.h"
+
+#include "MEM_guardedalloc.h"
+
+namespace {
+
+/* Sizes around the size class boundaries, and above the largest class. */
+const size_t test_sizes[] = {1, 7, 8, 16, 100, 248, 250, 1000, 4088, 4090, 10000, 100000};
+
+void FillAndCheck(const size_t len, const char value)
+{
+  char *mem = (char *)MEM_mallocN(len, "FillAndCheck");
+  EXPECT_GE(MEM_allocN_len(mem), len);
+  memset(mem, value, len);
+  for (size_t i = 0; i < len; i++) {
+    EXPECT_EQ(mem[i], value);
+  }
+  MEM_freeN(mem);
+}
+
+}  // namespace
+
+TEST(guardedalloc, ThreadCacheAllocFree)
+{
+  MEM_use_thread_cache_allocator();
+
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+
+  for (const size_t len : test_sizes) {
+    FillAndCheck(len, 42);
+
+    char *mem = (char *)MEM_callocN(len, "ThreadCacheCalloc");
+    for (size_t i = 0; i < len; i++) {
+      EXPECT_EQ(mem[i], 0);
+    }
+    mem = (char *)MEM_recallocN(mem, len * 2);
+    for (size_t i = 0; i < len * 2; i++) {
+      EXPECT_EQ(mem[i], 0);
+    }
+    MEM_freeN(mem);
+  }
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use);
+}
+
+TEST(guardedalloc, ThreadCacheCrossThreadFree)
+{
+  MEM_use_thread_cache_allocator();
+
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+  const size_t mem_in_use = MEM_get_memory_in_use();
+
+  /* Allocate on some threads and free on others, so blocks migrate between thread caches. */
+  const int threads_num = 4;
+  const int blocks_num = 10000;
+  std::vector<std::vector<void *>> blocks(threads_num);
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < threads_num; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < blocks_num; i++) {
+        const size_t len = test_sizes[(i + t) % ARRAY_SIZE(test_sizes)];
+        void *mem = MEM_mallocN(len, "ThreadCacheCrossThreadFree");
+        memset(mem, t, len);
+        blocks[t].push_back(mem);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use + threads_num * blocks_num);
+
+  for (int t = 0; t < threads_num; t++) {
+    threads.emplace_back([&, t]() {
+      for (void *mem : blocks[(t + 1) % threads_num]) {
+        MEM_freeN(mem);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+}
+
+TEST(guardedalloc, ThreadCacheThreadExit)
+{
+  MEM_use_thread_cache_allocator();
+
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+  const size_t mem_in_use = MEM_get_memory_in_use();
+
+  /* Short lived threads give their cached blocks back when they exit, and the blocks they leave
+   * allocated can be freed later by other threads. */
+  std::vector<void *> blocks;
+  for (int t = 0; t < 64; t++) {
+    std::thread thread([&, t]() {
+      std::vector<void *> temp;
+      for (int i = 0; i < 1000; i++) {
+        temp.push_back(MEM_mallocN(test_sizes[(i + t) % ARRAY_SIZE(test_sizes)], __func__));
+      }
+      blocks.push_back(temp.back());
+      temp.pop_back();
+      for (void *mem : temp) {
+        MEM_freeN(mem);
+      }
+    });
+    thread.join();
+  }
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use + blocks.size());
+  for (void *mem : blocks) {
+    MEM_freeN(mem);
+  }
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+}
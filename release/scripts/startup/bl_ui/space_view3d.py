@@ -2982,6 +2982,7 @@ class VIEW3D_MT_sculpt(Menu):
         layout.separator()
 
         layout.operator("sculpt.optimize")
+        layout.operator("object.mesh_spatial_sort")
 
 
 class VIEW3D_MT_mask(Menu):
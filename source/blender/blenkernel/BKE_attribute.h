@@ -67,6 +67,9 @@ bool BKE_id_attribute_remove(struct ID *id,
 AttributeDomain BKE_id_attribute_domain(struct ID *id, struct CustomDataLayer *layer);
 int BKE_id_attribute_data_length(struct ID *id, struct CustomDataLayer *layer);
 bool BKE_id_attribute_required(struct ID *id, struct CustomDataLayer *layer);
+/* Make the layer storing `data` mutable when its array is shared with other data-blocks, so it
+ * can be written to. Returns false when `data` is not in an attribute layer of the data-block. */
+bool BKE_id_attribute_data_ensure_mutable(struct ID *id, const void *data);
 bool BKE_id_attribute_rename(struct ID *id,
                              struct CustomDataLayer *layer,
                              const char *new_name,
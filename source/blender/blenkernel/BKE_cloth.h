@@ -29,6 +29,7 @@
 extern "C" {
 #endif
 
+struct BVHTreeOverlap;
 struct ClothModifierData;
 struct CollisionModifierData;
 struct Depsgraph;
@@ -96,6 +97,7 @@ typedef struct Cloth {
   float average_acceleration[3];  /* Moving average of overall acceleration. */
   struct MEdge *edges;            /* Used for hair collisions. */
   struct EdgeSet *sew_edge_graph; /* Sewing edges represented using a GHash */
+  struct ClothSelfOverlapCache *self_overlap_cache; /* Self collision candidates, collision.c */
 } Cloth;
 
 /**
@@ -230,6 +232,9 @@ int cloth_bvh_collision(struct Depsgraph *depsgraph,
                         struct ClothModifierData *clmd,
                         float step,
                         float dt);
+void cloth_self_overlap_cache_free(struct Cloth *cloth);
+struct BVHTreeOverlap *cloth_bvh_self_overlap_cached(struct ClothModifierData *clmd,
+                                                     unsigned int *r_overlap_num);
 
 ////////////////////////////////////////////////
 
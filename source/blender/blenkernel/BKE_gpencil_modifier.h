@@ -80,6 +80,12 @@ typedef enum {
   eGpencilModifierTypeFlag_NoUserAdd = (1 << 5),
   /** Can't be applied. */
   eGpencilModifierTypeFlag_NoApply = (1 << 6),
+
+  /**
+   * deformStroke() only modifies the given stroke and reads shared data,
+   * so strokes can be deformed from multiple threads.
+   */
+  eGpencilModifierTypeFlag_SupportsThreadedDeform = (1 << 7),
 } GpencilModifierTypeFlag;
 
 typedef void (*GreasePencilIDWalkFunc)(void *userData,
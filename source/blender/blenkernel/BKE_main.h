@@ -161,6 +161,13 @@ typedef struct Main {
    */
   struct MainIDRelations *relations;
 
+  /**
+   * Same as for relations above, only valid between #BKE_main_id_name_map_create and
+   * #BKE_main_id_name_map_free calls.
+   * Used by code creating or renaming a lot of IDs at once, to find unique names quickly.
+   */
+  struct MainIDNameMap *id_name_map;
+
   struct MainLock *lock;
 } Main;
 
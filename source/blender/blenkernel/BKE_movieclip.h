@@ -27,6 +27,7 @@
 extern "C" {
 #endif
 
+struct anim;
 struct Depsgraph;
 struct ImBuf;
 struct Main;
@@ -109,6 +110,9 @@ bool BKE_movieclip_has_cached_frame(struct MovieClip *clip, struct MovieClipUser
 bool BKE_movieclip_put_frame_if_possible(struct MovieClip *clip,
                                          struct MovieClipUser *user,
                                          struct ImBuf *ibuf);
+bool BKE_movieclip_prefetch_frame(struct MovieClip *clip,
+                                  struct MovieClipUser *user,
+                                  struct anim **anim_p);
 
 struct GPUTexture *BKE_movieclip_get_gpu_texture(struct MovieClip *clip,
                                                  struct MovieClipUser *cuser);
@@ -178,6 +178,10 @@ typedef struct ParticleThreadContext {
   struct CurveMapping *clumpcurve;
   struct CurveMapping *roughcurve;
   struct CurveMapping *twistcurve;
+
+  /* Per parent particle data shared by all its children, NULL when computed per child. */
+  float (*parent_hairmat)[4][4];
+  float (*parent_orco)[3];
 } ParticleThreadContext;
 
 typedef struct ParticleTask {
@@ -1758,6 +1758,70 @@ static void mesh_runtime_check_normals_valid(const Mesh *mesh)
   BLI_assert(!(mesh->runtime.cd_dirty_poly & CD_MASK_NORMAL));
 }
 
+/**
+ * The previous evaluated mesh of the object, when its batch cache can be kept for the next
+ * evaluation. This is the case when the input mesh is not modified and only deforming modifiers
+ * are used: the evaluated mesh then only differs by its vertex positions (e.g. armature or shape
+ * key animation), see #mesh_build_data_batch_cache_reuse.
+ */
+static Mesh *mesh_build_data_batch_cache_reuse_candidate(struct Depsgraph *depsgraph,
+                                                         Object *ob,
+                                                         const CustomData_MeshMasks *dataMask,
+                                                         const bool need_mapping)
+{
+  if (!DEG_is_active(depsgraph) || ob->mode != OB_MODE_OBJECT ||
+      ob->runtime.data_eval == NULL || !ob->runtime.is_data_eval_owned ||
+      ob->runtime.data_orig == NULL) {
+    return NULL;
+  }
+
+  Mesh *mesh_eval_prev = (Mesh *)ob->runtime.data_eval;
+  Mesh *mesh_input = (Mesh *)ob->runtime.data_orig;
+  if (GS(mesh_eval_prev->id.name) != ID_ME || mesh_eval_prev->runtime.batch_cache == NULL ||
+      !mesh_eval_prev->runtime.deformed_only) {
+    return NULL;
+  }
+
+  /* The input mesh was copied again, its topology or custom-data layers may have changed. */
+  if (mesh_input->id.recalc & ID_RECALC_COPY_ON_WRITE) {
+    return NULL;
+  }
+
+  /* Requested layers changed (e.g. #CD_ORCO added). */
+  if (ob->runtime.last_need_mapping != need_mapping ||
+      memcmp(&ob->runtime.last_data_mask, dataMask, sizeof(*dataMask)) != 0) {
+    return NULL;
+  }
+
+  return mesh_eval_prev;
+}
+
+/**
+ * Move the batch cache of the previous evaluated mesh to the new one, when the new one was only
+ * deformed too. It is then tagged with #BKE_MESH_BATCH_DIRTY_DEFORM instead of
+ * #BKE_MESH_BATCH_DIRTY_ALL, so only the buffers depending on vertex positions are extracted
+ * again.
+ */
+static void mesh_build_data_batch_cache_reuse(Mesh *mesh_eval_prev,
+                                              Mesh *mesh_eval,
+                                              const bool is_mesh_eval_owned)
+{
+  if (!is_mesh_eval_owned || !mesh_eval->runtime.deformed_only ||
+      mesh_eval->runtime.batch_cache != NULL) {
+    return;
+  }
+  if (mesh_eval->totvert != mesh_eval_prev->totvert ||
+      mesh_eval->totedge != mesh_eval_prev->totedge ||
+      mesh_eval->totloop != mesh_eval_prev->totloop ||
+      mesh_eval->totpoly != mesh_eval_prev->totpoly) {
+    return;
+  }
+
+  mesh_eval->runtime.batch_cache = mesh_eval_prev->runtime.batch_cache;
+  mesh_eval->runtime.batch_cache_deform_only = true;
+  mesh_eval_prev->runtime.batch_cache = NULL;
+}
+
 static void mesh_build_data(struct Depsgraph *depsgraph,
                             Scene *scene,
                             Object *ob,
@@ -1770,6 +1834,13 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
    * they aren't cleaned up properly on mode switch, causing crashes, e.g T58150. */
   BLI_assert(ob->id.tag & LIB_TAG_COPIED_ON_WRITE);
 
+  /* Keep the previous result alive until the new one is known, to move its batch cache. */
+  Mesh *mesh_eval_prev = mesh_build_data_batch_cache_reuse_candidate(
+      depsgraph, ob, dataMask, need_mapping);
+  if (mesh_eval_prev != NULL) {
+    ob->runtime.data_eval = NULL;
+  }
+
   BKE_object_free_derived_caches(ob);
   if (DEG_is_active(depsgraph)) {
     BKE_sculpt_update_object_before_eval(ob);
@@ -1807,6 +1878,11 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
   const bool is_mesh_eval_owned = (mesh_eval != mesh->runtime.mesh_eval);
   BKE_object_eval_assign_data(ob, &mesh_eval->id, is_mesh_eval_owned);
 
+  if (mesh_eval_prev != NULL) {
+    mesh_build_data_batch_cache_reuse(mesh_eval_prev, mesh_eval, is_mesh_eval_owned);
+    BKE_mesh_eval_delete(mesh_eval_prev);
+  }
+
   ob->runtime.mesh_deform_eval = mesh_deform_eval;
   ob->runtime.last_data_mask = *dataMask;
   ob->runtime.last_need_mapping = need_mapping;
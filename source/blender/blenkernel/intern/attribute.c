@@ -40,6 +40,7 @@
 #include "BKE_attribute.h"
 #include "BKE_customdata.h"
 #include "BKE_hair.h"
+#include "BKE_mesh.h"
 #include "BKE_pointcloud.h"
 #include "BKE_report.h"
 
@@ -222,6 +223,48 @@ int BKE_id_attribute_data_length(ID *id, CustomDataLayer *layer)
   return 0;
 }
 
+bool BKE_id_attribute_data_ensure_mutable(ID *id, const void *data)
+{
+  DomainInfo info[ATTR_DOMAIN_NUM];
+  get_domains(id, info);
+
+  for (AttributeDomain domain = 0; domain < ATTR_DOMAIN_NUM; domain++) {
+    CustomData *customdata = info[domain].customdata;
+    if (customdata == NULL) {
+      continue;
+    }
+    for (int i = 0; i < customdata->totlayer; i++) {
+      CustomDataLayer *layer = &customdata->layers[i];
+      const char *layer_data = layer->data;
+      const size_t layer_size = (size_t)CustomData_sizeof(layer->type) * info[domain].length;
+      if (layer_data == NULL || (const char *)data < layer_data ||
+          (const char *)data >= layer_data + layer_size) {
+        continue;
+      }
+      if ((layer->flag & CD_FLAG_NOFREE) || layer->share) {
+        const int n = i - CustomData_get_layer_index(customdata, layer->type);
+        CustomData_duplicate_referenced_layer_n(customdata, layer->type, n, info[domain].length);
+        switch (GS(id->name)) {
+          case ID_ME:
+            BKE_mesh_update_customdata_pointers((Mesh *)id, false);
+            break;
+          case ID_PT:
+            BKE_pointcloud_update_customdata_pointers((PointCloud *)id);
+            break;
+          case ID_HA:
+            BKE_hair_update_customdata_pointers((Hair *)id);
+            break;
+          default:
+            break;
+        }
+      }
+      return true;
+    }
+  }
+
+  return false;
+}
+
 bool BKE_id_attribute_required(ID *id, CustomDataLayer *layer)
 {
   switch (GS(id->name)) {
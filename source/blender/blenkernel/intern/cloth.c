@@ -476,6 +476,8 @@ void cloth_free_modifier(ClothModifierData *clmd)
       BLI_bvhtree_free(cloth->bvhselftree);
     }
 
+    cloth_self_overlap_cache_free(cloth);
+
     /* we save our faces for collision objects */
     if (cloth->tri) {
       MEM_freeN(cloth->tri);
@@ -558,6 +560,8 @@ void cloth_free_modifier_extern(ClothModifierData *clmd)
       BLI_bvhtree_free(cloth->bvhselftree);
     }
 
+    cloth_self_overlap_cache_free(cloth);
+
     /* we save our faces for collision objects */
     if (cloth->tri) {
       MEM_freeN(cloth->tri);
@@ -31,6 +31,7 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
+#include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_edgehash.h"
 #include "BLI_linklist.h"
@@ -1527,6 +1528,129 @@ static bool cloth_bvh_self_overlap_cb(void *userdata, int index_a, int index_b,
   return false;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Self Collision Overlap Cache
+ *
+ * The self collision BVH is queried with bounding volumes inflated by a margin, and the
+ * resulting candidate pairs are reused by the following substeps as long as no vertex moved
+ * further than that margin. Candidates are still tested for their exact distance, so the extra
+ * pairs only cost some narrow-phase work.
+ * \{ */
+
+/* Number of substeps at the current vertex velocities the margin should cover. */
+#define CLOTH_SELF_OVERLAP_MARGIN_STEPS 2.0f
+
+typedef struct ClothSelfOverlapCache {
+  BVHTreeOverlap *overlap;
+  uint overlap_num;
+  /* Vertex positions the overlaps were found at. */
+  float (*co)[3];
+  /* Vertices excluded from self collision (#CLOTH_VERT_FLAG_NOSELFCOLL) at that time. */
+  BLI_bitmap *noselfcoll;
+  uint co_num;
+  float margin;
+  /* Settings the overlaps depend on. */
+  float epsilon;
+  bool sewing_active;
+} ClothSelfOverlapCache;
+
+void cloth_self_overlap_cache_free(Cloth *cloth)
+{
+  ClothSelfOverlapCache *cache = cloth->self_overlap_cache;
+
+  if (cache) {
+    MEM_SAFE_FREE(cache->overlap);
+    MEM_SAFE_FREE(cache->co);
+    MEM_SAFE_FREE(cache->noselfcoll);
+    MEM_freeN(cache);
+    cloth->self_overlap_cache = NULL;
+  }
+}
+
+static bool cloth_self_overlap_cache_is_valid(const ClothModifierData *clmd,
+                                              const ClothSelfOverlapCache *cache)
+{
+  const Cloth *cloth = clmd->clothObject;
+  const bool sewing_active = (clmd->sim_parms->flags & CLOTH_SIMSETTINGS_FLAG_SEW);
+
+  if (cache->co == NULL || cache->co_num != cloth->mvert_num ||
+      cache->epsilon != clmd->coll_parms->selfepsilon || cache->sewing_active != sewing_active) {
+    return false;
+  }
+
+  const float margin_sq = square_f(cache->margin);
+  for (uint i = 0; i < cloth->mvert_num; i++) {
+    const ClothVertex *vert = &cloth->verts[i];
+    if (len_squared_v3v3(vert->tx, cache->co[i]) > margin_sq) {
+      return false;
+    }
+    /* Vertex groups can be changed by drivers or animation, this filters candidate pairs. */
+    if (((vert->flags & CLOTH_VERT_FLAG_NOSELFCOLL) != 0) !=
+        BLI_BITMAP_TEST_BOOL(cache->noselfcoll, i)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Return the self collision candidates for the current vertex positions (`tx`),
+ * the overlaps are owned by the cache.
+ */
+BVHTreeOverlap *cloth_bvh_self_overlap_cached(ClothModifierData *clmd, uint *r_overlap_num)
+{
+  Cloth *cloth = clmd->clothObject;
+  ClothSelfOverlapCache *cache = cloth->self_overlap_cache;
+
+  if (cache == NULL) {
+    cache = cloth->self_overlap_cache = MEM_callocN(sizeof(*cache), __func__);
+  }
+
+  if (!cloth_self_overlap_cache_is_valid(clmd, cache)) {
+    const ClothVertex *verts = cloth->verts;
+    const float epsilon = clmd->coll_parms->selfepsilon;
+    float max_step_sq = 0.0f;
+
+    if (cache->co_num != cloth->mvert_num) {
+      MEM_SAFE_FREE(cache->co);
+      MEM_SAFE_FREE(cache->noselfcoll);
+      cache->co = MEM_malloc_arrayN(cloth->mvert_num, sizeof(*cache->co), __func__);
+      cache->noselfcoll = BLI_BITMAP_NEW(cloth->mvert_num, __func__);
+      cache->co_num = cloth->mvert_num;
+    }
+
+    for (uint i = 0; i < cloth->mvert_num; i++) {
+      copy_v3_v3(cache->co[i], verts[i].tx);
+      BLI_BITMAP_SET(cache->noselfcoll, i, verts[i].flags & CLOTH_VERT_FLAG_NOSELFCOLL);
+      max_step_sq = max_ff(max_step_sq, len_squared_v3v3(verts[i].tx, verts[i].txold));
+    }
+
+    /* Cover the motion over the next substeps, but keep some margin for cloth which is
+     * (almost) at rest, otherwise any small motion would invalidate the cache. */
+    cache->margin = max_ff(sqrtf(max_step_sq) * CLOTH_SELF_OVERLAP_MARGIN_STEPS, epsilon * 0.5f);
+    cache->epsilon = epsilon;
+    cache->sewing_active = (clmd->sim_parms->flags & CLOTH_SIMSETTINGS_FLAG_SEW);
+
+    /* The inflation is scaled by the length of each (non normalized) k-DOP axis when nodes are
+     * updated, so the margin covers a vertex displacement of that distance in any direction. */
+    BLI_bvhtree_set_epsilon(cloth->bvhselftree, epsilon + cache->margin);
+    bvhtree_update_from_cloth(clmd, false, true);
+
+    MEM_SAFE_FREE(cache->overlap);
+    cache->overlap = BLI_bvhtree_overlap(cloth->bvhselftree,
+                                         cloth->bvhselftree,
+                                         &cache->overlap_num,
+                                         cloth_bvh_self_overlap_cb,
+                                         clmd);
+  }
+
+  *r_overlap_num = cache->overlap_num;
+  return cache->overlap;
+}
+
+/** \} */
+
 int cloth_bvh_collision(
     Depsgraph *depsgraph, Object *ob, ClothModifierData *clmd, float step, float dt)
 {
@@ -1584,11 +1708,8 @@ int cloth_bvh_collision(
     }
   }
 
-  if (clmd->coll_parms->flags & CLOTH_COLLSETTINGS_FLAG_SELF) {
-    bvhtree_update_from_cloth(clmd, false, true);
-
-    overlap_self = BLI_bvhtree_overlap(
-        cloth->bvhselftree, cloth->bvhselftree, &coll_count_self, cloth_bvh_self_overlap_cb, clmd);
+  if ((clmd->coll_parms->flags & CLOTH_COLLSETTINGS_FLAG_SELF) && cloth->bvhselftree) {
+    overlap_self = cloth_bvh_self_overlap_cached(clmd, &coll_count_self);
   }
 
   do {
@@ -1685,8 +1806,6 @@ int cloth_bvh_collision(
 
   MEM_SAFE_FREE(coll_counts_obj);
 
-  MEM_SAFE_FREE(overlap_self);
-
   BKE_collision_objects_free(collobjs);
 
   return MIN2(ret, 1);
@@ -0,0 +1,224 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include "testing/testing.h"
+
+#include <cstring>
+#include <set>
+#include <utility>
+
+#include "BKE_cloth.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_cloth_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_modifier_types.h"
+
+#include "BLI_kdopbvh.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.hh"
+
+namespace blender::bke::tests {
+
+struct ClothSelfOverlapTestContext {
+  ClothModifierData clmd;
+  ClothSimSettings sim_parms;
+  ClothCollSettings coll_parms;
+  Cloth cloth;
+  /* Tree of the plain self collision distance, queried from scratch at every step. */
+  BVHTree *bvhtree_ref;
+};
+
+static void tri_coords_get(const Cloth *cloth, int index, float co[3][3])
+{
+  for (int i = 0; i < 3; i++) {
+    copy_v3_v3(co[i], cloth->verts[cloth->tri[index].tri[i]].tx);
+  }
+}
+
+/* Separate triangles scattered in a small box, so that many of them overlap. */
+static void test_cloth_init(ClothSelfOverlapTestContext *ctx,
+                            RandomNumberGenerator *rng,
+                            int tri_num,
+                            float epsilon)
+{
+  memset(ctx, 0, sizeof(*ctx));
+  ctx->coll_parms.selfepsilon = epsilon;
+  ctx->clmd.sim_parms = &ctx->sim_parms;
+  ctx->clmd.coll_parms = &ctx->coll_parms;
+  ctx->clmd.clothObject = &ctx->cloth;
+
+  Cloth *cloth = &ctx->cloth;
+  cloth->mvert_num = tri_num * 3;
+  cloth->primitive_num = tri_num;
+  cloth->verts = (ClothVertex *)MEM_calloc_arrayN(
+      cloth->mvert_num, sizeof(*cloth->verts), __func__);
+  cloth->tri = (MVertTri *)MEM_calloc_arrayN(tri_num, sizeof(*cloth->tri), __func__);
+
+  for (int i = 0; i < tri_num; i++) {
+    float center[3];
+    for (int j = 0; j < 3; j++) {
+      center[j] = rng->get_float() * 2.0f;
+    }
+    for (int k = 0; k < 3; k++) {
+      const int v = i * 3 + k;
+      for (int j = 0; j < 3; j++) {
+        cloth->verts[v].tx[j] = center[j] + (rng->get_float() - 0.5f) * 0.1f;
+      }
+      copy_v3_v3(cloth->verts[v].txold, cloth->verts[v].tx);
+      cloth->tri[i].tri[k] = v;
+    }
+  }
+
+  cloth->bvhselftree = BLI_bvhtree_new(tri_num, epsilon, 4, 26);
+  ctx->bvhtree_ref = BLI_bvhtree_new(tri_num, epsilon, 4, 26);
+  for (int i = 0; i < tri_num; i++) {
+    float co[3][3];
+    tri_coords_get(cloth, i, co);
+    BLI_bvhtree_insert(cloth->bvhselftree, i, co[0], 3);
+    BLI_bvhtree_insert(ctx->bvhtree_ref, i, co[0], 3);
+  }
+  BLI_bvhtree_balance(cloth->bvhselftree);
+  BLI_bvhtree_balance(ctx->bvhtree_ref);
+}
+
+static void test_cloth_free(ClothSelfOverlapTestContext *ctx)
+{
+  cloth_self_overlap_cache_free(&ctx->cloth);
+  BLI_bvhtree_free(ctx->cloth.bvhselftree);
+  BLI_bvhtree_free(ctx->bvhtree_ref);
+  MEM_freeN(ctx->cloth.verts);
+  MEM_freeN(ctx->cloth.tri);
+}
+
+/* Move all vertices by `step` along the diagonals, the worst case for the 26-DOP. */
+static void test_cloth_move(ClothSelfOverlapTestContext *ctx,
+                            RandomNumberGenerator *rng,
+                            float step)
+{
+  Cloth *cloth = &ctx->cloth;
+  for (uint i = 0; i < cloth->mvert_num; i++) {
+    ClothVertex *vert = &cloth->verts[i];
+    copy_v3_v3(vert->txold, vert->tx);
+    for (int j = 0; j < 3; j++) {
+      vert->tx[j] += ((rng->get_int32() & 1) ? step : -step) / (float)M_SQRT3;
+    }
+  }
+}
+
+static bool test_overlap_cb(void *UNUSED(userdata), int index_a, int index_b, int UNUSED(thread))
+{
+  return index_a < index_b;
+}
+
+static std::set<std::pair<int, int>> overlap_set(const BVHTreeOverlap *overlap, uint overlap_num)
+{
+  std::set<std::pair<int, int>> pairs;
+  for (uint i = 0; i < overlap_num; i++) {
+    pairs.insert(std::make_pair(overlap[i].indexA, overlap[i].indexB));
+  }
+  return pairs;
+}
+
+TEST(cloth_collision, SelfOverlapCacheMatchesQuery)
+{
+  ClothSelfOverlapTestContext ctx;
+  RandomNumberGenerator rng;
+  test_cloth_init(&ctx, &rng, 2000, 0.015f);
+
+  /* The margin covers two steps, so the candidates are reused by the next two substeps. */
+  for (int substep = 0; substep < 100; substep++) {
+    test_cloth_move(&ctx, &rng, 0.01f);
+
+    uint overlap_num;
+    const BVHTreeOverlap *overlap = cloth_bvh_self_overlap_cached(&ctx.clmd, &overlap_num);
+    const std::set<std::pair<int, int>> pairs = overlap_set(overlap, overlap_num);
+
+    for (uint i = 0; i < ctx.cloth.primitive_num; i++) {
+      float co[3][3];
+      tri_coords_get(&ctx.cloth, i, co);
+      BLI_bvhtree_update_node(ctx.bvhtree_ref, i, co[0], nullptr, 3);
+    }
+    BLI_bvhtree_update_tree(ctx.bvhtree_ref);
+
+    uint overlap_ref_num;
+    BVHTreeOverlap *overlap_ref = BLI_bvhtree_overlap(
+        ctx.bvhtree_ref, ctx.bvhtree_ref, &overlap_ref_num, test_overlap_cb, nullptr);
+    EXPECT_GT(overlap_ref_num, 0u);
+
+    /* Every pair found by the plain query must be in the cached candidates. */
+    for (uint i = 0; i < overlap_ref_num; i++) {
+      const std::pair<int, int> pair(overlap_ref[i].indexA, overlap_ref[i].indexB);
+      EXPECT_TRUE(pairs.count(pair)) << "substep " << substep;
+    }
+    MEM_SAFE_FREE(overlap_ref);
+  }
+
+  test_cloth_free(&ctx);
+}
+
+/* The overlap query sets the self tree epsilon, a sentinel value tells whether it ran. */
+static bool test_overlap_cache_reused(ClothSelfOverlapTestContext *ctx, uint *r_overlap_num)
+{
+  const float sentinel = 1000.0f;
+  BLI_bvhtree_set_epsilon(ctx->cloth.bvhselftree, sentinel);
+  cloth_bvh_self_overlap_cached(&ctx->clmd, r_overlap_num);
+  return BLI_bvhtree_get_epsilon(ctx->cloth.bvhselftree) == sentinel;
+}
+
+TEST(cloth_collision, SelfOverlapCacheReuseAndInvalidate)
+{
+  ClothSelfOverlapTestContext ctx;
+  RandomNumberGenerator rng;
+  test_cloth_init(&ctx, &rng, 500, 0.015f);
+  Cloth *cloth = &ctx.cloth;
+
+  uint overlap_num;
+  test_cloth_move(&ctx, &rng, 0.01f);
+  EXPECT_FALSE(test_overlap_cache_reused(&ctx, &overlap_num));
+  EXPECT_GT(overlap_num, 0u);
+
+  /* Motion within the margin keeps the candidates. */
+  test_cloth_move(&ctx, &rng, 0.001f);
+  EXPECT_TRUE(test_overlap_cache_reused(&ctx, &overlap_num));
+  EXPECT_GT(overlap_num, 0u);
+
+  /* Motion beyond the margin finds new candidates. */
+  test_cloth_move(&ctx, &rng, 0.1f);
+  EXPECT_FALSE(test_overlap_cache_reused(&ctx, &overlap_num));
+  EXPECT_TRUE(test_overlap_cache_reused(&ctx, &overlap_num));
+
+  /* Excluding vertices from self collision drops their pairs. */
+  for (uint i = 0; i < cloth->mvert_num; i++) {
+    cloth->verts[i].flags |= CLOTH_VERT_FLAG_NOSELFCOLL;
+  }
+  EXPECT_FALSE(test_overlap_cache_reused(&ctx, &overlap_num));
+  EXPECT_EQ(overlap_num, 0u);
+  for (uint i = 0; i < cloth->mvert_num; i++) {
+    cloth->verts[i].flags &= ~CLOTH_VERT_FLAG_NOSELFCOLL;
+  }
+  EXPECT_FALSE(test_overlap_cache_reused(&ctx, &overlap_num));
+  EXPECT_GT(overlap_num, 0u);
+
+  /* So does the self collision distance. */
+  ctx.coll_parms.selfepsilon = 0.02f;
+  EXPECT_FALSE(test_overlap_cache_reused(&ctx, &overlap_num));
+  EXPECT_TRUE(test_overlap_cache_reused(&ctx, &overlap_num));
+
+  test_cloth_free(&ctx);
+}
+
+}  // namespace blender::bke::tests
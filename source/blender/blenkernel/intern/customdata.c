@@ -61,6 +61,8 @@
 
 #include "CLG_log.h"
 
+#include "atomic_ops.h"
+
 /* only for customdata_data_transfer_interp_normal_normals */
 #include "data_transfer_intern.h"
 
@@ -2035,6 +2037,94 @@ void customData_mask_layers__print(const CustomData_MeshMasks *mask)
   }
 }
 
+/********************* Layer data sharing *********************/
+
+/* Layers copied with #CD_SHARE point to the same data array as their source layer, the array is
+ * owned by all of them and only freed when its last user frees it. A shared layer is duplicated
+ * when it's made mutable, see #CustomData_duplicate_referenced_layer. */
+typedef struct CustomDataLayerShare {
+  /** Number of layers using the data, including the layer it was first shared from. */
+  int users;
+} CustomDataLayerShare;
+
+static bool customData_layer_can_share(const CustomDataLayer *layer)
+{
+  return layer->data && !(layer->flag & (CD_FLAG_NOFREE | CD_FLAG_EXTERNAL));
+}
+
+/* Add a user to the data of the layer, returns the share to store in the new user's layer. */
+static CustomDataLayerShare *customData_layer_share_acquire(CustomDataLayer *layer)
+{
+  if (layer->share == NULL) {
+    CustomDataLayerShare *share = MEM_mallocN(sizeof(*share), __func__);
+    share->users = 1;
+    /* The same source can be shared from different threads at once, e.g. when it's copied
+     * on write by several dependency graphs. */
+    if (atomic_cas_ptr((void **)&layer->share, NULL, share) != NULL) {
+      MEM_freeN(share);
+    }
+  }
+  atomic_add_and_fetch_int32(&layer->share->users, 1);
+  return layer->share;
+}
+
+/* Remove the layer from the users of its shared data. Returns true when it was the last user,
+ * in which case the layer owns the data again. */
+static bool customData_layer_share_release(CustomDataLayer *layer)
+{
+  CustomDataLayerShare *share = layer->share;
+  layer->share = NULL;
+  if (atomic_sub_and_fetch_int32(&share->users, 1) == 0) {
+    MEM_freeN(share);
+    return true;
+  }
+  return false;
+}
+
+static void *customData_layer_data_duplicate(const CustomDataLayer *layer, const int totelem)
+{
+  /* MEM_dupallocN won't work in case of complex layers, like e.g.
+   * CD_MDEFORMVERT, which has pointers to allocated data...
+   * So in case a custom copy function is defined, use it!
+   */
+  const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+
+  if (typeInfo->copy) {
+    void *dst_data = MEM_malloc_arrayN((size_t)totelem, typeInfo->size, "CD duplicate ref layer");
+    typeInfo->copy(layer->data, dst_data, totelem);
+    return dst_data;
+  }
+  return MEM_dupallocN(layer->data);
+}
+
+static void customData_layer_data_free(int type, void *data, int totelem)
+{
+  const LayerTypeInfo *typeInfo = layerType_getInfo(type);
+
+  if (typeInfo->free) {
+    typeInfo->free(data, totelem, typeInfo->size);
+  }
+  MEM_freeN(data);
+}
+
+/* Make the layer the only owner of its data, duplicating it if it's still used elsewhere. */
+static void customData_layer_unshare(CustomDataLayer *layer, const int totelem)
+{
+  if (layer->share->users == 1) {
+    /* Other users are gone, no one can add a user to the data without going through this layer. */
+    MEM_freeN(layer->share);
+    layer->share = NULL;
+    return;
+  }
+
+  void *data = customData_layer_data_duplicate(layer, totelem);
+  if (customData_layer_share_release(layer)) {
+    /* Other users released the data in the meantime. */
+    customData_layer_data_free(layer->type, layer->data, totelem);
+  }
+  layer->data = data;
+}
+
 /********************* CustomData functions *********************/
 static void customData_update_offsets(CustomData *data);
 
@@ -2123,6 +2213,7 @@ bool CustomData_merge(const struct CustomData *source,
       case CD_ASSIGN:
       case CD_REFERENCE:
       case CD_DUPLICATE:
+      case CD_SHARE:
         data = layer->data;
         break;
       default:
@@ -2134,6 +2225,26 @@ bool CustomData_merge(const struct CustomData *source,
       newlayer = customData_add_layer__internal(
           dest, type, CD_REFERENCE, data, totelem, layer->name);
     }
+    else if (alloctype == CD_ASSIGN) {
+      newlayer = customData_add_layer__internal(dest, type, CD_ASSIGN, data, totelem, layer->name);
+      if (newlayer) {
+        /* Ownership is moved to the new layer, including its part of shared data. */
+        newlayer->share = layer->share;
+      }
+    }
+    else if (alloctype == CD_SHARE) {
+      if (customData_layer_can_share(layer)) {
+        newlayer = customData_add_layer__internal(
+            dest, type, CD_ASSIGN, data, totelem, layer->name);
+        if (newlayer) {
+          newlayer->share = customData_layer_share_acquire(layer);
+        }
+      }
+      else {
+        newlayer = customData_add_layer__internal(
+            dest, type, CD_DUPLICATE, data, totelem, layer->name);
+      }
+    }
     else {
       newlayer = customData_add_layer__internal(dest, type, alloctype, data, totelem, layer->name);
     }
@@ -2164,6 +2275,9 @@ void CustomData_realloc(CustomData *data, int totelem)
       continue;
     }
     typeInfo = layerType_getInfo(layer->type);
+    if (layer->share) {
+      customData_layer_unshare(layer, (int)(MEM_allocN_len(layer->data) / typeInfo->size));
+    }
     layer->data = MEM_reallocN(layer->data, (size_t)totelem * typeInfo->size);
   }
 }
@@ -2185,18 +2299,12 @@ void CustomData_copy(const struct CustomData *source,
 
 static void customData_free_layer__internal(CustomDataLayer *layer, int totelem)
 {
-  const LayerTypeInfo *typeInfo;
-
   if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
-    typeInfo = layerType_getInfo(layer->type);
-
-    if (typeInfo->free) {
-      typeInfo->free(layer->data, totelem, typeInfo->size);
-    }
-
-    if (layer->data) {
-      MEM_freeN(layer->data);
+    if (layer->share && !customData_layer_share_release(layer)) {
+      /* Data is still used by other layers. */
+      return;
     }
+    customData_layer_data_free(layer->type, layer->data, totelem);
   }
 }
 
@@ -2562,6 +2670,7 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
   data->layers[index].type = type;
   data->layers[index].flag = flag;
   data->layers[index].data = newlayerdata;
+  data->layers[index].share = NULL;
 
   /* Set default name if none exists. Note we only call DATA_()  once
    * we know there is a default name, to avoid overhead of locale lookups
@@ -2744,24 +2853,12 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
   CustomDataLayer *layer = &data->layers[layer_index];
 
   if (layer->flag & CD_FLAG_NOFREE) {
-    /* MEM_dupallocN won't work in case of complex layers, like e.g.
-     * CD_MDEFORMVERT, which has pointers to allocated data...
-     * So in case a custom copy function is defined, use it!
-     */
-    const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
-
-    if (typeInfo->copy) {
-      void *dst_data = MEM_malloc_arrayN(
-          (size_t)totelem, typeInfo->size, "CD duplicate ref layer");
-      typeInfo->copy(layer->data, dst_data, totelem);
-      layer->data = dst_data;
-    }
-    else {
-      layer->data = MEM_dupallocN(layer->data);
-    }
-
+    layer->data = customData_layer_data_duplicate(layer, totelem);
     layer->flag &= ~CD_FLAG_NOFREE;
   }
+  else if (layer->share) {
+    customData_layer_unshare(layer, totelem);
+  }
 
   return layer->data;
 }
@@ -2806,7 +2903,7 @@ bool CustomData_is_referenced_layer(struct CustomData *data, int type)
 
   CustomDataLayer *layer = &data->layers[layer_index];
 
-  return (layer->flag & CD_FLAG_NOFREE) != 0;
+  return (layer->flag & CD_FLAG_NOFREE) != 0 || (layer->share && layer->share->users > 1);
 }
 
 void CustomData_free_temporary(CustomData *data, int totelem)
@@ -3251,6 +3348,10 @@ void *CustomData_set_layer(const CustomData *data, int type, void *ptr)
     return NULL;
   }
 
+  if (data->layers[layer_index].share) {
+    /* The old data stays owned by its other users, or the caller when this was the last one. */
+    customData_layer_share_release(&data->layers[layer_index]);
+  }
   data->layers[layer_index].data = ptr;
 
   return ptr;
@@ -3264,6 +3365,10 @@ void *CustomData_set_layer_n(const struct CustomData *data, int type, int n, voi
     return NULL;
   }
 
+  if (data->layers[layer_index].share) {
+    /* The old data stays owned by its other users, or the caller when this was the last one. */
+    customData_layer_share_release(&data->layers[layer_index]);
+  }
   data->layers[layer_index].data = ptr;
 
   return ptr;
@@ -4244,7 +4349,9 @@ void CustomData_blend_write_prepare(CustomData *data,
         }
         write_layers_size += chunk_size;
       }
-      write_layers[j++] = *layer;
+      write_layers[j] = *layer;
+      write_layers[j].share = NULL;
+      j++;
     }
   }
   BLI_assert(j == data->totlayer);
@@ -5173,6 +5280,7 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, int count)
     }
 
     layer->flag &= ~CD_FLAG_NOFREE;
+    layer->share = NULL;
 
     if (CustomData_verify_versions(data, i)) {
       BLO_read_data_address(reader, &layer->data);
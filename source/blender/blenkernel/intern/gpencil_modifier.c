@@ -29,6 +29,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -714,6 +715,88 @@ void BKE_gpencil_prepare_eval_data(Depsgraph *depsgraph, Scene *scene, Object *o
   BKE_gpencil_update_orig_pointers(ob_orig, ob);
 }
 
+typedef struct GpencilDeformStroke {
+  bGPDlayer *gpl;
+  bGPDframe *gpf;
+  bGPDstroke *gps;
+} GpencilDeformStroke;
+
+typedef struct GpencilDeformData {
+  GpencilModifierData *md;
+  const GpencilModifierTypeInfo *mti;
+  Depsgraph *depsgraph;
+  Object *ob;
+  GpencilDeformStroke *strokes;
+} GpencilDeformData;
+
+static void gpencil_deform_strokes_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GpencilDeformData *data = userdata;
+  GpencilDeformStroke *stroke = &data->strokes[i];
+  data->mti->deformStroke(
+      data->md, data->depsgraph, data->ob, stroke->gpl, stroke->gpf, stroke->gps);
+}
+
+/**
+ * Apply a deform modifier to the strokes of all evaluated frames.
+ *
+ * The strokes are gathered into a single array first, so that modifiers which support it can
+ * deform them in parallel instead of walking the stroke list of every frame.
+ */
+static void gpencil_modifier_deform_strokes(Depsgraph *depsgraph,
+                                            Scene *scene,
+                                            Object *ob,
+                                            GpencilModifierData *md,
+                                            const GpencilModifierTypeInfo *mti)
+{
+  bGPdata *gpd = (bGPdata *)ob->data;
+  int strokes_len = 0;
+
+  LISTBASE_FOREACH (bGPDlayer *, gpl, &gpd->layers) {
+    bGPDframe *gpf = BKE_gpencil_frame_retime_get(depsgraph, scene, ob, gpl);
+    if (gpf != NULL) {
+      strokes_len += BLI_listbase_count(&gpf->strokes);
+    }
+  }
+  if ((mti->deformStroke == NULL) || (strokes_len == 0)) {
+    return;
+  }
+
+  GpencilDeformStroke *strokes = MEM_malloc_arrayN(strokes_len, sizeof(*strokes), __func__);
+  int i = 0;
+  LISTBASE_FOREACH (bGPDlayer *, gpl, &gpd->layers) {
+    bGPDframe *gpf = BKE_gpencil_frame_retime_get(depsgraph, scene, ob, gpl);
+    if (gpf == NULL) {
+      continue;
+    }
+    int stroke_index = 0;
+    LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
+      gps->runtime.stroke_index = stroke_index++;
+      strokes[i].gpl = gpl;
+      strokes[i].gpf = gpf;
+      strokes[i].gps = gps;
+      i++;
+    }
+  }
+
+  GpencilDeformData data = {
+      .md = md,
+      .mti = mti,
+      .depsgraph = depsgraph,
+      .ob = ob,
+      .strokes = strokes,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (mti->flags & eGpencilModifierTypeFlag_SupportsThreadedDeform) != 0;
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, strokes_len, &data, gpencil_deform_strokes_cb, &settings);
+
+  MEM_freeN(strokes);
+}
+
 /** Calculate gpencil modifiers.
  * \param depsgraph: Current depsgraph
  * \param scene: Current scene
@@ -752,18 +835,7 @@ void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
 
       /* Apply deform modifiers and Time remap (only change geometry). */
       if ((time_remap) || (mti && mti->deformStroke)) {
-        LISTBASE_FOREACH (bGPDlayer *, gpl, &gpd->layers) {
-          bGPDframe *gpf = BKE_gpencil_frame_retime_get(depsgraph, scene, ob, gpl);
-          if (gpf == NULL) {
-            continue;
-          }
-
-          if (mti->deformStroke) {
-            LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
-              mti->deformStroke(md, depsgraph, ob, gpl, gpf, gps);
-            }
-          }
-        }
+        gpencil_modifier_deform_strokes(depsgraph, scene, ob, md, mti);
       }
     }
   }
@@ -45,6 +45,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_alloca.h"
+#include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
 #include "BLI_linklist.h"
@@ -151,7 +152,7 @@ static void lib_id_clear_library_data_ex(Main *bmain, ID *id)
   id->tag &= ~(LIB_TAG_INDIRECT | LIB_TAG_EXTERN);
   id->flag &= ~LIB_INDIRECT_WEAK_LINK;
   if (id_in_mainlist) {
-    if (BKE_id_new_name_validate(which_libbase(bmain, GS(id->name)), id, NULL)) {
+    if (BKE_id_new_name_validate(bmain, which_libbase(bmain, GS(id->name)), id, NULL)) {
       bmain->is_memfile_undo_written = false;
     }
   }
@@ -812,7 +813,7 @@ void BKE_libblock_management_main_add(Main *bmain, void *idv)
   ListBase *lb = which_libbase(bmain, GS(id->name));
   BKE_main_lock(bmain);
   BLI_addtail(lb, id);
-  BKE_id_new_name_validate(lb, id, NULL);
+  BKE_id_new_name_validate(bmain, lb, id, NULL);
   /* alphabetic insertion: is in new_id */
   id->tag &= ~(LIB_TAG_NO_MAIN | LIB_TAG_NO_USER_REFCOUNT);
   bmain->is_memfile_undo_written = false;
@@ -835,6 +836,7 @@ void BKE_libblock_management_main_remove(Main *bmain, void *idv)
 
   ListBase *lb = which_libbase(bmain, GS(id->name));
   BKE_main_lock(bmain);
+  BKE_main_id_name_map_remove(bmain, id);
   BLI_remlink(lb, id);
   id->tag |= LIB_TAG_NO_MAIN;
   bmain->is_memfile_undo_written = false;
@@ -944,7 +946,7 @@ void BKE_main_id_flag_all(Main *bmain, const int flag, const bool value)
   }
 }
 
-void BKE_main_id_repair_duplicate_names_listbase(ListBase *lb)
+void BKE_main_id_repair_duplicate_names_listbase(Main *bmain, ListBase *lb)
 {
   int lb_len = 0;
   LISTBASE_FOREACH (ID *, id, lb) {
@@ -968,7 +970,7 @@ void BKE_main_id_repair_duplicate_names_listbase(ListBase *lb)
   }
   for (i = 0; i < lb_len; i++) {
     if (!BLI_gset_add(gset, id_array[i]->name + 2)) {
-      BKE_id_new_name_validate(lb, id_array[i], NULL);
+      BKE_id_new_name_validate(bmain, lb, id_array[i], NULL);
     }
   }
   BLI_gset_free(gset, NULL);
@@ -1071,7 +1073,7 @@ void *BKE_libblock_alloc(Main *bmain, short type, const char *name, const int fl
 
       BKE_main_lock(bmain);
       BLI_addtail(lb, id);
-      BKE_id_new_name_validate(lb, id, name);
+      BKE_id_new_name_validate(bmain, lb, id, name);
       bmain->is_memfile_undo_written = false;
       /* alphabetic insertion: is in new_id */
       BKE_main_unlock(bmain);
@@ -1441,6 +1443,245 @@ static bool id_name_final_build(char *name, char *base_name, size_t base_name_le
   return true;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Main ID Name Map
+ *
+ * Optional index of the names of all local IDs of a Main, used instead of the list scans in
+ * #check_for_dupid when it exists, so that creating or renaming many IDs is not quadratic.
+ *
+ * \note Like #Main.relations, it is only kept in sync by the ID management code in this file
+ * and #BKE_id_free_ex, so it should only exist while a single operation creates many IDs.
+ * \{ */
+
+/** Suffix numbers used by the IDs sharing a same base name. */
+typedef struct IDNameMapBase {
+  /** Used numbers in [0 .. MAX_NUMBERS_IN_USE - 1]. */
+  BLI_bitmap numbers_in_use[_BITMAP_NUM_BLOCKS(MAX_NUMBERS_IN_USE)];
+  /** Highest number ever used, may be higher than the current highest one after removals. */
+  int number_max;
+} IDNameMapBase;
+
+typedef struct MainIDNameMap {
+  /** Full ID names (including the ID code) to their local ID. */
+  GHash *id_by_name;
+  /** Local IDs to their key in #id_by_name, so that they can be removed without reading their
+   * name, which may have been changed outside of the map. */
+  GHash *name_by_id;
+  /** Base names (including the ID code, without number suffix) to their #IDNameMapBase. */
+  GHash *base_by_name;
+} MainIDNameMap;
+
+/* Build the key of given name (without ID code) in the maps. */
+static void id_name_map_key(char key[MAX_ID_NAME], const short id_type, const char *name)
+{
+  *((short *)key) = id_type;
+  BLI_strncpy(key + 2, name, MAX_ID_NAME - 2);
+}
+
+/* Get the base of given full name (including the ID code), and the number of its suffix. */
+static IDNameMapBase *id_name_map_base_get(MainIDNameMap *name_map,
+                                           const char *name,
+                                           int *r_number)
+{
+  char base_name[MAX_ID_NAME - 2];
+  char key[MAX_ID_NAME];
+  BLI_split_name_num(base_name, r_number, name + 2, '.');
+  id_name_map_key(key, *((const short *)name), base_name);
+  return BLI_ghash_lookup(name_map->base_by_name, key);
+}
+
+static void id_name_map_remove(MainIDNameMap *name_map, ID *id)
+{
+  char *key = BLI_ghash_popkey(name_map->name_by_id, id, NULL);
+  if (key == NULL) {
+    return;
+  }
+
+  int number;
+  IDNameMapBase *base = id_name_map_base_get(name_map, key, &number);
+  if (base != NULL && number < MAX_NUMBERS_IN_USE) {
+    /* Another name may use the same number ("name.1" and "name.001"), in which case the bit is
+     * set again when that name is found by #check_for_dupid_name_map. */
+    BLI_BITMAP_DISABLE(base->numbers_in_use, number);
+  }
+
+  BLI_ghash_remove(name_map->id_by_name, key, MEM_freeN, NULL);
+}
+
+/* Get the ID using given name, discarding entries of IDs renamed outside of the map. */
+static ID *id_name_map_lookup(MainIDNameMap *name_map, const short id_type, const char *name)
+{
+  char key[MAX_ID_NAME];
+  id_name_map_key(key, id_type, name);
+
+  ID *id = BLI_ghash_lookup(name_map->id_by_name, key);
+  if (id != NULL && !STREQ(id->name, key)) {
+    id_name_map_remove(name_map, id);
+    return NULL;
+  }
+  return id;
+}
+
+static void id_name_map_add(MainIDNameMap *name_map, ID *id)
+{
+  if (ID_IS_LINKED(id)) {
+    return;
+  }
+
+  id_name_map_remove(name_map, id);
+
+  void **key_p, **val_p;
+  if (BLI_ghash_ensure_p_ex(name_map->id_by_name, id->name, &key_p, &val_p)) {
+    /* The entry of an ID renamed outside of the map. */
+    BLI_ghash_remove(name_map->name_by_id, *val_p, NULL, NULL);
+  }
+  else {
+    *key_p = BLI_strdup(id->name);
+  }
+  *val_p = id;
+  BLI_ghash_insert(name_map->name_by_id, id, *key_p);
+
+  char base_name[MAX_ID_NAME - 2];
+  char key[MAX_ID_NAME];
+  int number;
+  BLI_split_name_num(base_name, &number, id->name + 2, '.');
+  id_name_map_key(key, GS(id->name), base_name);
+
+  if (!BLI_ghash_ensure_p_ex(name_map->base_by_name, key, &key_p, &val_p)) {
+    *key_p = BLI_strdup(key);
+    *val_p = MEM_callocN(sizeof(IDNameMapBase), __func__);
+  }
+  IDNameMapBase *base = *val_p;
+  if (number < MAX_NUMBERS_IN_USE) {
+    BLI_BITMAP_ENABLE(base->numbers_in_use, number);
+  }
+  base->number_max = MAX2(base->number_max, number);
+}
+
+/**
+ * Same as #check_for_dupid, using the name map instead of scanning the whole list.
+ * Given \a id is expected to not be in the map.
+ *
+ * Numbers are only marked as used in the map when an ID is added with them, so that names
+ * truncated by #id_name_final_build do not leave a used number behind for their previous base.
+ */
+static bool check_for_dupid_name_map(MainIDNameMap *name_map,
+                                     ID *id,
+                                     char *name,
+                                     ID **r_id_sorting_hint)
+{
+  const short id_type = GS(id->name);
+  bool is_name_changed = false;
+
+  *r_id_sorting_hint = NULL;
+
+  while (true) {
+    /* Get the name and number parts ("name.number"). */
+    char base_name[MAX_ID_NAME - 2];
+    int number = MIN_NUMBER;
+    size_t base_name_len = BLI_split_name_num(base_name, &number, name, '.');
+
+    ID *id_test = id_name_map_lookup(name_map, id_type, name);
+    if (id_test == NULL || id_test == id) {
+      return is_name_changed;
+    }
+
+    char key[MAX_ID_NAME];
+    id_name_map_key(key, id_type, base_name);
+    IDNameMapBase *base = BLI_ghash_lookup(name_map->base_by_name, key);
+    BLI_assert(base != NULL);
+
+    /* The number of the found ID is in use, even if another name using it was removed. */
+    if (number < MAX_NUMBERS_IN_USE) {
+      BLI_BITMAP_ENABLE(base->numbers_in_use, number);
+    }
+    if (number >= MAX_NUMBER || number < MIN_NUMBER) {
+      number = MIN_NUMBER;
+    }
+
+    /* Smallest unused number if possible, otherwise first largest unused one. */
+    number = MAX2(number, base->number_max + 1);
+    for (int i = MIN_NUMBER; i < MAX_NUMBERS_IN_USE; i++) {
+      if (!BLI_BITMAP_TEST(base->numbers_in_use, i)) {
+        number = i;
+        break;
+      }
+    }
+
+    /* We know for sure that name will be changed. */
+    is_name_changed = true;
+
+    /* If id_name_final_build helper returns false, it had to truncate further given name, hence
+     * we have to go over the whole check again. */
+    if (!id_name_final_build(name, base_name, base_name_len, number)) {
+      continue;
+    }
+
+    /* Insert after the ID using the previous number, if any. */
+    if (number > MIN_NUMBER) {
+      char name_prev[MAX_ID_NAME - 2];
+      BLI_strncpy(name_prev, name, sizeof(name_prev));
+      if (id_name_final_build(name_prev, base_name, base_name_len, number - 1)) {
+        *r_id_sorting_hint = id_name_map_lookup(name_map, id_type, name_prev);
+      }
+    }
+    else {
+      *r_id_sorting_hint = id_name_map_lookup(name_map, id_type, base_name);
+    }
+
+    /* Different names can share a same number ("name.1" and "name.001"), so the final name is
+     * checked again. */
+  }
+}
+
+/**
+ * Create the name map of given \a bmain, making all following ID creations and renames through
+ * the ID management API use it, until #BKE_main_id_name_map_free is called.
+ */
+void BKE_main_id_name_map_create(Main *bmain)
+{
+  if (bmain->id_name_map != NULL) {
+    BKE_main_id_name_map_free(bmain);
+  }
+
+  MainIDNameMap *name_map = MEM_mallocN(sizeof(*name_map), __func__);
+  name_map->id_by_name = BLI_ghash_str_new(__func__);
+  name_map->name_by_id = BLI_ghash_ptr_new(__func__);
+  name_map->base_by_name = BLI_ghash_str_new(__func__);
+
+  ID *id;
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    id_name_map_add(name_map, id);
+  }
+  FOREACH_MAIN_ID_END;
+
+  bmain->id_name_map = name_map;
+}
+
+void BKE_main_id_name_map_free(Main *bmain)
+{
+  if (bmain->id_name_map != NULL) {
+    BLI_ghash_free(bmain->id_name_map->name_by_id, NULL, NULL);
+    BLI_ghash_free(bmain->id_name_map->id_by_name, MEM_freeN, NULL);
+    BLI_ghash_free(bmain->id_name_map->base_by_name, MEM_freeN, MEM_freeN);
+    MEM_freeN(bmain->id_name_map);
+    bmain->id_name_map = NULL;
+  }
+}
+
+/**
+ * Remove given \a id from the name map of \a bmain, if any (when it is removed from Main or
+ * freed). Does not read the ID name, which may have been changed outside of the map.
+ */
+void BKE_main_id_name_map_remove(Main *bmain, ID *id)
+{
+  if (bmain->id_name_map != NULL) {
+    id_name_map_remove(bmain->id_name_map, id);
+  }
+}
+
+/** \} */
+
 /**
  * Check to see if an ID name is already used, and find a new one if so.
  * Return true if a new name was created (returned in name).
@@ -1648,9 +1889,12 @@ static bool check_for_dupid(ListBase *lb, ID *id, char *name, ID **r_id_sorting_
  *
  * Only for local IDs (linked ones already have a unique ID in their library).
  *
+ * \param bmain: The Main owning \a lb, used for its #Main.id_name_map. May be NULL when the
+ * list is not part of a Main (e.g. in versioning code).
+ *
  * \return true if a new name had to be created.
  */
-bool BKE_id_new_name_validate(ListBase *lb, ID *id, const char *tname)
+bool BKE_id_new_name_validate(Main *bmain, ListBase *lb, ID *id, const char *tname)
 {
   bool result;
   char name[MAX_ID_NAME - 2];
@@ -1679,8 +1923,18 @@ bool BKE_id_new_name_validate(ListBase *lb, ID *id, const char *tname)
   }
 
   ID *id_sorting_hint = NULL;
-  result = check_for_dupid(lb, id, name, &id_sorting_hint);
+  MainIDNameMap *name_map = (bmain != NULL) ? bmain->id_name_map : NULL;
+  if (name_map != NULL) {
+    id_name_map_remove(name_map, id);
+    result = check_for_dupid_name_map(name_map, id, name, &id_sorting_hint);
+  }
+  else {
+    result = check_for_dupid(lb, id, name, &id_sorting_hint);
+  }
   strcpy(id->name + 2, name);
+  if (name_map != NULL) {
+    id_name_map_add(name_map, id);
+  }
 
   /* This was in 2.43 and previous releases
    * however all data in blender should be sorted, not just duplicate names
@@ -2138,7 +2392,7 @@ void BLI_libblock_ensure_unique_name(Main *bmain, const char *name)
   idtest = BLI_findstring(lb, name + 2, offsetof(ID, name) + 2);
   if (idtest != NULL) {
     /* BKE_id_new_name_validate also takes care of sorting. */
-    BKE_id_new_name_validate(lb, idtest, NULL);
+    BKE_id_new_name_validate(bmain, lb, idtest, NULL);
     bmain->is_memfile_undo_written = false;
   }
 }
@@ -2149,7 +2403,7 @@ void BLI_libblock_ensure_unique_name(Main *bmain, const char *name)
 void BKE_libblock_rename(Main *bmain, ID *id, const char *name)
 {
   ListBase *lb = which_libbase(bmain, GS(id->name));
-  if (BKE_id_new_name_validate(lb, id, name)) {
+  if (BKE_id_new_name_validate(bmain, lb, id, name)) {
     bmain->is_memfile_undo_written = false;
   }
 }
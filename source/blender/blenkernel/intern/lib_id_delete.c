@@ -173,6 +173,12 @@ void BKE_id_free_ex(Main *bmain, void *idv, int flag, const bool use_flag_from_i
     }
   }
 
+  if (bmain != NULL) {
+    /* Also done for IDs not in Main anymore, they may have been removed from it without the ID
+     * management API, and the name map must never keep pointers to freed IDs. */
+    BKE_main_id_name_map_remove(bmain, id);
+  }
+
   if ((flag & LIB_ID_FREE_NO_MAIN) == 0) {
     ListBase *lb = which_libbase(bmain, type);
     BLI_remlink(lb, id);
@@ -276,6 +282,7 @@ static void id_delete(Main *bmain, const bool do_tagged_deletion)
           id_next = id->next;
           /* Note: in case we delete a library, we also delete all its datablocks! */
           if ((id->tag & tag) || (id->lib != NULL && (id->lib->id.tag & tag))) {
+            BKE_main_id_name_map_remove(bmain, id);
             BLI_remlink(lb, id);
             BLI_addtail(&tagged_deleted_ids, id);
             /* Do not tag as no_main now, we want to unlink it first (lower-level ID management
@@ -0,0 +1,210 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_ghash.h"
+#include "BLI_listbase.h"
+#include "BLI_string.h"
+
+#include "DNA_ID.h"
+#include "DNA_object_types.h"
+
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_main.h"
+
+namespace blender::bke::tests {
+
+struct LibIDNameMapTestContext {
+  Main *bmain;
+};
+
+static void test_lib_id_name_map_init(LibIDNameMapTestContext *ctx)
+{
+  BKE_idtype_init();
+  ctx->bmain = BKE_main_new();
+}
+
+static void test_lib_id_name_map_free(LibIDNameMapTestContext *ctx)
+{
+  BKE_main_free(ctx->bmain);
+}
+
+/* Check that all local IDs of given list have a different name. */
+static void test_lib_id_names_unique(ListBase *lb)
+{
+  GSet *names = BLI_gset_str_new(__func__);
+  LISTBASE_FOREACH (ID *, id, lb) {
+    if (id->lib == nullptr) {
+      EXPECT_TRUE(BLI_gset_add(names, id->name)) << id->name << " is used twice";
+    }
+  }
+  BLI_gset_free(names, nullptr);
+}
+
+TEST(lib_id_name_map, create)
+{
+  LibIDNameMapTestContext ctx;
+  test_lib_id_name_map_init(&ctx);
+
+  BKE_id_new(ctx.bmain, ID_OB, "OB");
+  BKE_main_id_name_map_create(ctx.bmain);
+
+  ID *id_a = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB");
+  ID *id_b = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB");
+  ID *id_c = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB.001");
+  EXPECT_STREQ(id_a->name + 2, "OB.001");
+  EXPECT_STREQ(id_b->name + 2, "OB.002");
+  EXPECT_STREQ(id_c->name + 2, "OB.003");
+  test_lib_id_names_unique(&ctx.bmain->objects);
+
+  BKE_main_id_name_map_free(ctx.bmain);
+  test_lib_id_name_map_free(&ctx);
+}
+
+TEST(lib_id_name_map, rename)
+{
+  LibIDNameMapTestContext ctx;
+  test_lib_id_name_map_init(&ctx);
+
+  BKE_main_id_name_map_create(ctx.bmain);
+
+  BKE_id_new(ctx.bmain, ID_OB, "OB");
+  ID *id_a = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB");
+  ID *id_b = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB");
+  EXPECT_STREQ(id_b->name + 2, "OB.002");
+
+  /* Renaming frees the previous name. */
+  BKE_libblock_rename(ctx.bmain, id_a, "Other");
+  EXPECT_STREQ(id_a->name + 2, "Other");
+  ID *id_c = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB");
+  EXPECT_STREQ(id_c->name + 2, "OB.001");
+
+  BKE_libblock_rename(ctx.bmain, id_b, "Other");
+  EXPECT_STREQ(id_b->name + 2, "Other.001");
+  test_lib_id_names_unique(&ctx.bmain->objects);
+
+  BKE_main_id_name_map_free(ctx.bmain);
+  test_lib_id_name_map_free(&ctx);
+}
+
+TEST(lib_id_name_map, remove)
+{
+  LibIDNameMapTestContext ctx;
+  test_lib_id_name_map_init(&ctx);
+
+  BKE_main_id_name_map_create(ctx.bmain);
+
+  ID *id_a = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB");
+  ID *id_b = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB");
+  EXPECT_STREQ(id_b->name + 2, "OB.001");
+
+  BKE_id_free(ctx.bmain, id_a);
+  id_us_min(id_b);
+  BKE_id_delete(ctx.bmain, id_b);
+
+  ID *id_c = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB");
+  ID *id_d = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB");
+  EXPECT_STREQ(id_c->name + 2, "OB");
+  EXPECT_STREQ(id_d->name + 2, "OB.001");
+  test_lib_id_names_unique(&ctx.bmain->objects);
+
+  BKE_main_id_name_map_free(ctx.bmain);
+  test_lib_id_name_map_free(&ctx);
+}
+
+TEST(lib_id_name_map, make_local)
+{
+  LibIDNameMapTestContext ctx;
+  test_lib_id_name_map_init(&ctx);
+
+  Library *lib = (Library *)BKE_id_new(ctx.bmain, ID_LI, "LI");
+  BKE_id_new(ctx.bmain, ID_OB, "OB");
+  ID *id_linked = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB.001");
+  id_linked->lib = lib;
+
+  /* Linked IDs are not in the map, their name only gets checked when made local. */
+  BKE_main_id_name_map_create(ctx.bmain);
+  BKE_id_new(ctx.bmain, ID_OB, "OB");
+  test_lib_id_names_unique(&ctx.bmain->objects);
+
+  BKE_lib_id_clear_library_data(ctx.bmain, id_linked);
+  EXPECT_EQ(id_linked->lib, nullptr);
+  EXPECT_STREQ(id_linked->name + 2, "OB.002");
+
+  /* The name of the ID made local must be used by following creations. */
+  ID *id_new = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB.002");
+  EXPECT_STREQ(id_new->name + 2, "OB.003");
+  test_lib_id_names_unique(&ctx.bmain->objects);
+
+  BKE_main_id_name_map_free(ctx.bmain);
+  test_lib_id_name_map_free(&ctx);
+}
+
+TEST(lib_id_name_map, truncated_names)
+{
+  LibIDNameMapTestContext ctx, ctx_map;
+  test_lib_id_name_map_init(&ctx);
+  test_lib_id_name_map_init(&ctx_map);
+
+  /* Longest possible name, numbers are only added by truncating it. */
+  char name_long[MAX_ID_NAME - 2];
+  memset(name_long, 'A', sizeof(name_long) - 1);
+  name_long[sizeof(name_long) - 1] = '\0';
+
+  /* The map must give the same names as the list scan, also after truncated names are removed. */
+  BKE_main_id_name_map_create(ctx_map.bmain);
+  for (int pass = 0; pass < 2; pass++) {
+    ID *ids[2][4];
+    for (int i = 0; i < 4; i++) {
+      ids[0][i] = (ID *)BKE_id_new(ctx.bmain, ID_OB, name_long);
+      ids[1][i] = (ID *)BKE_id_new(ctx_map.bmain, ID_OB, name_long);
+      EXPECT_STREQ(ids[0][i]->name, ids[1][i]->name);
+    }
+    BKE_id_free(ctx.bmain, ids[0][1]);
+    BKE_id_free(ctx_map.bmain, ids[1][1]);
+  }
+  test_lib_id_names_unique(&ctx_map.bmain->objects);
+
+  BKE_main_id_name_map_free(ctx_map.bmain);
+  test_lib_id_name_map_free(&ctx_map);
+  test_lib_id_name_map_free(&ctx);
+}
+
+TEST(lib_id_name_map, rename_outside_map)
+{
+  LibIDNameMapTestContext ctx;
+  test_lib_id_name_map_init(&ctx);
+
+  BKE_main_id_name_map_create(ctx.bmain);
+
+  ID *id_a = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB");
+  /* Renamed without the ID management API, the map still has it under its previous name. */
+  BLI_strncpy(id_a->name + 2, "Other", sizeof(id_a->name) - 2);
+  BKE_id_free(ctx.bmain, id_a);
+
+  /* Freeing the ID must remove it from the map, the previous name is available again. */
+  ID *id_b = (ID *)BKE_id_new(ctx.bmain, ID_OB, "OB");
+  EXPECT_STREQ(id_b->name + 2, "OB");
+  test_lib_id_names_unique(&ctx.bmain->objects);
+
+  BKE_main_id_name_map_free(ctx.bmain);
+  test_lib_id_name_map_free(&ctx);
+}
+
+}  // namespace blender::bke::tests
@@ -193,6 +193,9 @@ void BKE_main_free(Main *mainvar)
   if (mainvar->relations) {
     BKE_main_relations_free(mainvar);
   }
+  if (mainvar->id_name_map) {
+    BKE_main_id_name_map_free(mainvar);
+  }
 
   BLI_spin_end((SpinLock *)mainvar->lock);
   MEM_freeN(mainvar->lock);
@@ -0,0 +1,335 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bke
+ *
+ * Reorder mesh elements so that spatially close elements are also close in memory.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_listbase.h"
+#include "BLI_math.h"
+#include "BLI_utildefines.h"
+
+#include "DNA_key_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+#include "BKE_customdata.h"
+#include "BKE_mesh.h"
+#include "BKE_mesh_runtime.h"
+
+/* -------------------------------------------------------------------- */
+/** \name Morton Codes
+ * \{ */
+
+/* Bits per axis, 3 * 21 bits fit in a 64 bit key. */
+#define MORTON_BITS 21
+
+/* Spread the lower 21 bits of x so there are two zero bits between each of them. */
+static uint64_t morton_spread_bits(uint64_t x)
+{
+  x &= 0x1fffff;
+  x = (x | x << 32) & 0x1f00000000ffff;
+  x = (x | x << 16) & 0x1f0000ff0000ff;
+  x = (x | x << 8) & 0x100f00f00f00f00f;
+  x = (x | x << 4) & 0x10c30c30c30c30c3;
+  x = (x | x << 2) & 0x1249249249249249;
+  return x;
+}
+
+static uint64_t morton_code(const float co[3], const float min[3], const float scale[3])
+{
+  uint64_t code = 0;
+  for (int axis = 0; axis < 3; axis++) {
+    const float f = (co[axis] - min[axis]) * scale[axis];
+    const uint64_t cell = (uint64_t)clamp_f(f, 0.0f, (float)((1 << MORTON_BITS) - 1));
+    code |= morton_spread_bits(cell) << axis;
+  }
+  return code;
+}
+
+typedef struct MeshSortElem {
+  uint64_t key;
+  int index;
+} MeshSortElem;
+
+static int mesh_sort_elem_cmp(const void *a, const void *b)
+{
+  const MeshSortElem *x1 = a, *x2 = b;
+
+  if (x1->key != x2->key) {
+    return (x1->key > x2->key) ? 1 : -1;
+  }
+  /* Keep the current order of elements in the same cell. */
+  return (x1->index > x2->index) - (x1->index < x2->index);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Element Reordering
+ * \{ */
+
+/* Permute all layers of `data` so that the new element `i` is the old element `new_to_old[i]`.
+ * Layers keep their flags and names, only their arrays are replaced. */
+static void mesh_customdata_reorder(CustomData *data, const int *new_to_old, const int totelem)
+{
+  for (int i = 0; i < data->totlayer; i++) {
+    CustomDataLayer *layer = &data->layers[i];
+    if (layer->data == NULL) {
+      continue;
+    }
+
+    /* The array may be referenced or shared by other (e.g. evaluated) data, own it first. */
+    const int n = i - CustomData_get_layer_index(data, layer->type);
+    const char *data_src = CustomData_duplicate_referenced_layer_n(
+        data, layer->type, n, totelem);
+
+    /* Elements are moved without their copy callbacks, so the allocations they own (e.g.
+     * deform weights) are moved along with them. */
+    const size_t size = (size_t)CustomData_sizeof(layer->type);
+    char *data_dst = MEM_malloc_arrayN((size_t)totelem, size, __func__);
+    for (int j = 0; j < totelem; j++) {
+      memcpy(data_dst + (size_t)j * size, data_src + (size_t)new_to_old[j] * size, size);
+    }
+
+    MEM_freeN((void *)data_src);
+    layer->data = data_dst;
+  }
+}
+
+/* Walk the sorted faces and give each vertex and edge its index on first use, so that the
+ * elements referenced by a group of neighboring faces end up in a contiguous range. */
+static void mesh_sort_verts_edges_by_polys(const Mesh *mesh,
+                                           const int *poly_new_to_old,
+                                           int *vert_new_to_old,
+                                           int *vert_old_to_new,
+                                           int *edge_new_to_old,
+                                           int *edge_old_to_new)
+{
+  int vert_len = 0, edge_len = 0;
+
+  copy_vn_i(vert_old_to_new, mesh->totvert, -1);
+  copy_vn_i(edge_old_to_new, mesh->totedge, -1);
+
+  for (int i = 0; i < mesh->totpoly; i++) {
+    const MPoly *mp = &mesh->mpoly[poly_new_to_old[i]];
+    const MLoop *ml = &mesh->mloop[mp->loopstart];
+    for (int j = 0; j < mp->totloop; j++, ml++) {
+      if (vert_old_to_new[ml->v] == -1) {
+        vert_old_to_new[ml->v] = vert_len;
+        vert_new_to_old[vert_len++] = (int)ml->v;
+      }
+      if (edge_old_to_new[ml->e] == -1) {
+        edge_old_to_new[ml->e] = edge_len;
+        edge_new_to_old[edge_len++] = (int)ml->e;
+      }
+    }
+  }
+
+  /* Loose edges, then loose vertices, keep their current relative order. */
+  for (int i = 0; i < mesh->totedge; i++) {
+    if (edge_old_to_new[i] == -1) {
+      const MEdge *me = &mesh->medge[i];
+      edge_old_to_new[i] = edge_len;
+      edge_new_to_old[edge_len++] = i;
+      if (vert_old_to_new[me->v1] == -1) {
+        vert_old_to_new[me->v1] = vert_len;
+        vert_new_to_old[vert_len++] = (int)me->v1;
+      }
+      if (vert_old_to_new[me->v2] == -1) {
+        vert_old_to_new[me->v2] = vert_len;
+        vert_new_to_old[vert_len++] = (int)me->v2;
+      }
+    }
+  }
+  for (int i = 0; i < mesh->totvert; i++) {
+    if (vert_old_to_new[i] == -1) {
+      vert_old_to_new[i] = vert_len;
+      vert_new_to_old[vert_len++] = i;
+    }
+  }
+
+  BLI_assert(vert_len == mesh->totvert);
+  BLI_assert(edge_len == mesh->totedge);
+}
+
+static void mesh_keys_reorder(Mesh *mesh, const int *vert_new_to_old)
+{
+  if (mesh->key == NULL) {
+    return;
+  }
+
+  LISTBASE_FOREACH (KeyBlock *, kb, &mesh->key->block) {
+    BLI_assert(kb->totelem == mesh->totvert);
+    const float(*co_src)[3] = kb->data;
+    float(*co_dst)[3] = MEM_malloc_arrayN((size_t)kb->totelem, sizeof(float[3]), __func__);
+    for (int i = 0; i < kb->totelem; i++) {
+      copy_v3_v3(co_dst[i], co_src[vert_new_to_old[i]]);
+    }
+    MEM_freeN(kb->data);
+    kb->data = co_dst;
+  }
+}
+
+static void mesh_mselect_reorder(Mesh *mesh,
+                                 const int *vert_old_to_new,
+                                 const int *edge_old_to_new,
+                                 const int *poly_old_to_new)
+{
+  for (int i = 0; i < mesh->totselect; i++) {
+    MSelect *msel = &mesh->mselect[i];
+    switch (msel->type) {
+      case ME_VSEL:
+        msel->index = vert_old_to_new[msel->index];
+        break;
+      case ME_ESEL:
+        msel->index = edge_old_to_new[msel->index];
+        break;
+      case ME_FSEL:
+        msel->index = poly_old_to_new[msel->index];
+        break;
+    }
+  }
+}
+
+/**
+ * Reorder vertices, edges, faces and face corners along a Z-order curve of the face centers,
+ * so that the faces of a PBVH leaf (and the vertices they use) occupy nearly contiguous ranges
+ * of the mesh arrays, which makes sculpting and other localized operations more cache friendly.
+ *
+ * All custom-data layers, shape keys and the selection history are remapped, other data
+ * referencing vertex indices (hooks, vertex parents) is not.
+ *
+ * \return false when the mesh is left unchanged because it has shape keys with another vertex
+ * count, which could not be reordered along with the vertices.
+ */
+bool BKE_mesh_spatial_sort(Mesh *mesh)
+{
+  if (mesh->key != NULL) {
+    LISTBASE_FOREACH (KeyBlock *, kb, &mesh->key->block) {
+      if (kb->totelem != mesh->totvert) {
+        return false;
+      }
+    }
+  }
+
+  if (mesh->totpoly == 0) {
+    return true;
+  }
+
+  float min[3], max[3], scale[3];
+  INIT_MINMAX(min, max);
+  if (!BKE_mesh_minmax(mesh, min, max)) {
+    return true;
+  }
+  for (int axis = 0; axis < 3; axis++) {
+    const float extent = max[axis] - min[axis];
+    scale[axis] = (extent > 0.0f) ? (float)((1 << MORTON_BITS) - 1) / extent : 0.0f;
+  }
+
+  /* Sort faces by the Z-order of their centers. */
+  MeshSortElem *poly_sort = MEM_malloc_arrayN(
+      (size_t)mesh->totpoly, sizeof(*poly_sort), __func__);
+  for (int i = 0; i < mesh->totpoly; i++) {
+    const MPoly *mp = &mesh->mpoly[i];
+    float cent[3];
+    BKE_mesh_calc_poly_center(mp, &mesh->mloop[mp->loopstart], mesh->mvert, cent);
+    poly_sort[i].key = morton_code(cent, min, scale);
+    poly_sort[i].index = i;
+  }
+  qsort(poly_sort, (size_t)mesh->totpoly, sizeof(*poly_sort), mesh_sort_elem_cmp);
+
+  int *poly_new_to_old = MEM_malloc_arrayN((size_t)mesh->totpoly, sizeof(int), __func__);
+  int *poly_old_to_new = MEM_malloc_arrayN((size_t)mesh->totpoly, sizeof(int), __func__);
+  for (int i = 0; i < mesh->totpoly; i++) {
+    poly_new_to_old[i] = poly_sort[i].index;
+    poly_old_to_new[poly_sort[i].index] = i;
+  }
+  MEM_freeN(poly_sort);
+
+  int *vert_new_to_old = MEM_malloc_arrayN((size_t)mesh->totvert, sizeof(int), __func__);
+  int *vert_old_to_new = MEM_malloc_arrayN((size_t)mesh->totvert, sizeof(int), __func__);
+  int *edge_new_to_old = MEM_malloc_arrayN((size_t)mesh->totedge, sizeof(int), __func__);
+  int *edge_old_to_new = MEM_malloc_arrayN((size_t)mesh->totedge, sizeof(int), __func__);
+  mesh_sort_verts_edges_by_polys(
+      mesh, poly_new_to_old, vert_new_to_old, vert_old_to_new, edge_new_to_old, edge_old_to_new);
+
+  /* Face corners follow the new face order. */
+  int *loop_new_to_old = MEM_malloc_arrayN((size_t)mesh->totloop, sizeof(int), __func__);
+  {
+    int loop_len = 0;
+    for (int i = 0; i < mesh->totpoly; i++) {
+      const MPoly *mp = &mesh->mpoly[poly_new_to_old[i]];
+      for (int j = 0; j < mp->totloop; j++) {
+        loop_new_to_old[loop_len++] = mp->loopstart + j;
+      }
+    }
+    BLI_assert(loop_len == mesh->totloop);
+  }
+
+  /* Tessellated faces reference the old order and are recalculated on demand. */
+  BKE_mesh_tessface_clear(mesh);
+
+  mesh_customdata_reorder(&mesh->vdata, vert_new_to_old, mesh->totvert);
+  mesh_customdata_reorder(&mesh->edata, edge_new_to_old, mesh->totedge);
+  mesh_customdata_reorder(&mesh->ldata, loop_new_to_old, mesh->totloop);
+  mesh_customdata_reorder(&mesh->pdata, poly_new_to_old, mesh->totpoly);
+  BKE_mesh_update_customdata_pointers(mesh, false);
+
+  /* Update the indices stored in the elements themselves. */
+  for (int i = 0; i < mesh->totedge; i++) {
+    MEdge *me = &mesh->medge[i];
+    me->v1 = (uint)vert_old_to_new[me->v1];
+    me->v2 = (uint)vert_old_to_new[me->v2];
+  }
+  for (int i = 0; i < mesh->totloop; i++) {
+    MLoop *ml = &mesh->mloop[i];
+    ml->v = (uint)vert_old_to_new[ml->v];
+    ml->e = (uint)edge_old_to_new[ml->e];
+  }
+  {
+    int loopstart = 0;
+    for (int i = 0; i < mesh->totpoly; i++) {
+      MPoly *mp = &mesh->mpoly[i];
+      mp->loopstart = loopstart;
+      loopstart += mp->totloop;
+    }
+  }
+
+  mesh_keys_reorder(mesh, vert_new_to_old);
+  mesh_mselect_reorder(mesh, vert_old_to_new, edge_old_to_new, poly_old_to_new);
+
+  BKE_mesh_runtime_clear_geometry(mesh);
+
+  MEM_freeN(poly_new_to_old);
+  MEM_freeN(poly_old_to_new);
+  MEM_freeN(vert_new_to_old);
+  MEM_freeN(vert_old_to_new);
+  MEM_freeN(edge_new_to_old);
+  MEM_freeN(edge_old_to_new);
+  MEM_freeN(loop_new_to_old);
+
+  return true;
+}
+
+/** \} */
@@ -0,0 +1,207 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_listbase.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.hh"
+
+#include "DNA_customdata_types.h"
+#include "DNA_key_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+#include "BKE_customdata.h"
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+
+namespace blender::bke::tests {
+
+/* Grid of `size` by `size` quads, with vertices and faces in random order. */
+static Mesh *test_mesh_sort_grid_new(const int size)
+{
+  const int verts_len = (size + 1) * (size + 1);
+  const int polys_len = size * size;
+  Mesh *mesh = BKE_mesh_new_nomain(verts_len, 0, 0, polys_len * 4, polys_len);
+
+  RandomNumberGenerator rng;
+  std::vector<int> vert_order(verts_len), poly_order(polys_len);
+  std::iota(vert_order.begin(), vert_order.end(), 0);
+  std::iota(poly_order.begin(), poly_order.end(), 0);
+  rng.shuffle<int>(vert_order);
+  rng.shuffle<int>(poly_order);
+
+  for (int y = 0; y <= size; y++) {
+    for (int x = 0; x <= size; x++) {
+      MVert *mv = &mesh->mvert[vert_order[y * (size + 1) + x]];
+      copy_v3_fl3(mv->co, (float)x, (float)y, 0.0f);
+    }
+  }
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      const int poly_index = poly_order[y * size + x];
+      MPoly *mp = &mesh->mpoly[poly_index];
+      mp->loopstart = poly_index * 4;
+      mp->totloop = 4;
+      MLoop *ml = &mesh->mloop[mp->loopstart];
+      ml[0].v = vert_order[y * (size + 1) + x];
+      ml[1].v = vert_order[y * (size + 1) + x + 1];
+      ml[2].v = vert_order[(y + 1) * (size + 1) + x + 1];
+      ml[3].v = vert_order[(y + 1) * (size + 1) + x];
+    }
+  }
+  BKE_mesh_calc_edges(mesh, false, false);
+
+  return mesh;
+}
+
+/* Add an integer layer storing the current index of each element. */
+static void test_mesh_sort_index_layer_add(CustomData *data, const int totelem, const char *name)
+{
+  int *index = (int *)CustomData_add_layer_named(
+      data, CD_PROP_INT32, CD_CALLOC, nullptr, totelem, name);
+  for (int i = 0; i < totelem; i++) {
+    index[i] = i;
+  }
+}
+
+TEST(mesh_sort, SpatialSort)
+{
+  BKE_idtype_init();
+
+  const int size = 32;
+  Mesh *mesh = test_mesh_sort_grid_new(size);
+  test_mesh_sort_index_layer_add(&mesh->vdata, mesh->totvert, "vert_index");
+  test_mesh_sort_index_layer_add(&mesh->edata, mesh->totedge, "edge_index");
+  test_mesh_sort_index_layer_add(&mesh->pdata, mesh->totpoly, "poly_index");
+  /* Layers which are not copied along with their elements must still be reordered. */
+  const int layer_index = CustomData_get_named_layer_index(
+      &mesh->pdata, CD_PROP_INT32, "poly_index");
+  mesh->pdata.layers[layer_index].flag |= CD_FLAG_NOCOPY;
+
+  Mesh *mesh_orig = BKE_mesh_copy_for_eval(mesh, false);
+
+  EXPECT_TRUE(BKE_mesh_spatial_sort(mesh));
+
+  ASSERT_EQ(mesh->totvert, mesh_orig->totvert);
+  ASSERT_EQ(mesh->totedge, mesh_orig->totedge);
+  ASSERT_EQ(mesh->totloop, mesh_orig->totloop);
+  ASSERT_EQ(mesh->totpoly, mesh_orig->totpoly);
+
+  const int *vert_index = (const int *)CustomData_get_layer_named(
+      &mesh->vdata, CD_PROP_INT32, "vert_index");
+  const int *edge_index = (const int *)CustomData_get_layer_named(
+      &mesh->edata, CD_PROP_INT32, "edge_index");
+  const int *poly_index = (const int *)CustomData_get_layer_named(
+      &mesh->pdata, CD_PROP_INT32, "poly_index");
+  ASSERT_NE(vert_index, nullptr);
+  ASSERT_NE(edge_index, nullptr);
+  ASSERT_NE(poly_index, nullptr);
+
+  /* Elements are the same as before, only in a different order. */
+  for (int i = 0; i < mesh->totvert; i++) {
+    EXPECT_V3_NEAR(mesh->mvert[i].co, mesh_orig->mvert[vert_index[i]].co, 0.0f);
+  }
+  for (int i = 0; i < mesh->totedge; i++) {
+    const MEdge *me = &mesh->medge[i];
+    const MEdge *me_orig = &mesh_orig->medge[edge_index[i]];
+    const uint v1 = (uint)vert_index[me->v1], v2 = (uint)vert_index[me->v2];
+    EXPECT_EQ(std::min(v1, v2), std::min(me_orig->v1, me_orig->v2));
+    EXPECT_EQ(std::max(v1, v2), std::max(me_orig->v1, me_orig->v2));
+  }
+  int loopstart = 0;
+  for (int i = 0; i < mesh->totpoly; i++) {
+    const MPoly *mp = &mesh->mpoly[i];
+    const MPoly *mp_orig = &mesh_orig->mpoly[poly_index[i]];
+    EXPECT_EQ(mp->loopstart, loopstart);
+    ASSERT_EQ(mp->totloop, mp_orig->totloop);
+    for (int j = 0; j < mp->totloop; j++) {
+      const MLoop *ml = &mesh->mloop[mp->loopstart + j];
+      const MLoop *ml_orig = &mesh_orig->mloop[mp_orig->loopstart + j];
+      EXPECT_EQ((uint)vert_index[ml->v], ml_orig->v);
+      EXPECT_EQ((uint)edge_index[ml->e], ml_orig->e);
+    }
+    loopstart += mp->totloop;
+  }
+
+  /* Vertices are numbered in the order the sorted faces first use them. */
+  std::vector<bool> vert_used(mesh->totvert, false);
+  uint vert_used_len = 0;
+  for (int i = 0; i < mesh->totloop; i++) {
+    const uint v = mesh->mloop[i].v;
+    if (!vert_used[v]) {
+      EXPECT_EQ(v, vert_used_len);
+      vert_used[v] = true;
+      vert_used_len++;
+    }
+  }
+
+  /* Consecutive faces are close to each other. */
+  float dist_sum = 0.0f;
+  for (int i = 1; i < mesh->totpoly; i++) {
+    float cent_a[3], cent_b[3];
+    BKE_mesh_calc_poly_center(
+        &mesh->mpoly[i - 1], &mesh->mloop[mesh->mpoly[i - 1].loopstart], mesh->mvert, cent_a);
+    BKE_mesh_calc_poly_center(
+        &mesh->mpoly[i], &mesh->mloop[mesh->mpoly[i].loopstart], mesh->mvert, cent_b);
+    dist_sum += len_v3v3(cent_a, cent_b);
+  }
+  EXPECT_LT(dist_sum / (mesh->totpoly - 1), 2.0f);
+
+  BKE_id_free(nullptr, mesh);
+  BKE_id_free(nullptr, mesh_orig);
+}
+
+TEST(mesh_sort, SpatialSortMismatchedShapeKey)
+{
+  BKE_idtype_init();
+
+  Mesh *mesh = test_mesh_sort_grid_new(4);
+  Mesh *mesh_orig = BKE_mesh_copy_for_eval(mesh, false);
+
+  /* A shape key with fewer vertices than the mesh cannot follow the new vertex order. */
+  Key key = {{nullptr}};
+  KeyBlock *kb = (KeyBlock *)MEM_callocN(sizeof(KeyBlock), __func__);
+  kb->totelem = mesh->totvert - 1;
+  kb->data = MEM_calloc_arrayN(kb->totelem, sizeof(float[3]), __func__);
+  BLI_addtail(&key.block, kb);
+  mesh->key = &key;
+
+  EXPECT_FALSE(BKE_mesh_spatial_sort(mesh));
+
+  /* The mesh is left unchanged. */
+  for (int i = 0; i < mesh->totvert; i++) {
+    EXPECT_V3_NEAR(mesh->mvert[i].co, mesh_orig->mvert[i].co, 0.0f);
+  }
+  for (int i = 0; i < mesh->totloop; i++) {
+    EXPECT_EQ(mesh->mloop[i].v, mesh_orig->mloop[i].v);
+  }
+
+  mesh->key = nullptr;
+  MEM_freeN(kb->data);
+  MEM_freeN(kb);
+  BKE_id_free(nullptr, mesh);
+  BKE_id_free(nullptr, mesh_orig);
+}
+
+}  // namespace blender::bke::tests
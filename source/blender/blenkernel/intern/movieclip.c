@@ -1985,6 +1985,59 @@ bool BKE_movieclip_put_frame_if_possible(MovieClip *clip, MovieClipUser *user, I
   return result;
 }
 
+/**
+ * Read the frame of \a user into the clip cache, unless it is already cached.
+ *
+ * Unlike #BKE_movieclip_get_ibuf, the frame is decoded without holding #LOCK_MOVIECLIP, so other
+ * threads can keep reading cached frames of the clip meanwhile. Movies are decoded through
+ * \a anim_p, an animation handle owned by the caller which is opened on first use, since the
+ * handle of the clip itself can only be used under the lock. Proxies are not supported.
+ *
+ * \return false when the frame could not be read or did not fit into the cache.
+ */
+bool BKE_movieclip_prefetch_frame(MovieClip *clip, MovieClipUser *user, struct anim **anim_p)
+{
+  ImBuf *ibuf = NULL;
+
+  BLI_assert(user->render_size == MCLIP_PROXY_RENDER_SIZE_FULL);
+
+  if (BKE_movieclip_has_cached_frame(clip, user)) {
+    return true;
+  }
+
+  if (clip->source == MCLIP_SRC_SEQUENCE) {
+    ibuf = movieclip_load_sequence_file(clip, user, user->framenr, clip->flag);
+  }
+  else if (clip->source == MCLIP_SRC_MOVIE) {
+    if (*anim_p == NULL) {
+      char name[FILE_MAX];
+      BKE_movieclip_filename_for_frame(clip, user, name);
+      *anim_p = openanim(name, IB_rect, 0, clip->colorspace_settings.name);
+
+      if (*anim_p && (clip->flag & MCLIP_USE_PROXY_CUSTOM_DIR)) {
+        char dir[FILE_MAX];
+        BLI_strncpy(dir, clip->proxy.dir, sizeof(dir));
+        BLI_path_abs(dir, BKE_main_blendfile_path_from_global());
+        IMB_anim_set_index_dir(*anim_p, dir);
+      }
+    }
+
+    if (*anim_p) {
+      int fra = user->framenr - clip->start_frame + clip->frame_offset;
+      ibuf = IMB_anim_absolute(*anim_p, fra, get_timecode(clip, clip->flag), IMB_PROXY_NONE);
+    }
+  }
+
+  if (ibuf == NULL) {
+    return false;
+  }
+
+  bool result = BKE_movieclip_put_frame_if_possible(clip, user, ibuf);
+  IMB_freeImBuf(ibuf);
+
+  return result;
+}
+
 static void movieclip_selection_sync(MovieClip *clip_dst, const MovieClip *clip_src)
 {
   BLI_assert(clip_dst != clip_src);
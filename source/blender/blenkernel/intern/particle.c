@@ -2520,6 +2520,38 @@ static void psys_task_init_path(ParticleTask *task, ParticleSimulationData *sim)
   task->rng_path = BLI_rng_new(seed);
 }
 
+static void psys_child_parent_orco(ParticleThreadContext *ctx, ParticleData *pa, float r_orco[3])
+{
+  float co[3];
+
+  psys_particle_on_emitter(ctx->sim.psmd,
+                           ctx->sim.psys->part->from,
+                           pa->num,
+                           pa->num_dmcache,
+                           pa->fuv,
+                           pa->foffset,
+                           co,
+                           NULL,
+                           NULL,
+                           NULL,
+                           r_orco);
+}
+
+/* Edit updates only cache the data of modified parents, other parents are only used by children
+ * which are not recalculated, or as secondary parents of modified children. */
+static bool psys_child_parent_data_cached(const ParticleThreadContext *ctx,
+                                          const PTCacheEdit *edit,
+                                          int p)
+{
+  if (ctx->parent_hairmat == NULL) {
+    return false;
+  }
+  if (ctx->editupdate) {
+    return edit && (edit->points[p].flag & PEP_EDIT_RECALC);
+  }
+  return true;
+}
+
 /* note: this function must be thread safe, except for branching! */
 static void psys_thread_create_path(ParticleTask *task,
                                     struct ChildParticle *cpa,
@@ -2650,7 +2682,12 @@ static void psys_thread_create_path(ParticleTask *task,
       sub_v3_v3v3(off1[w], co, key[w]->co);
     }
 
-    psys_mat_hair_to_global(ob, ctx->sim.psmd->mesh_final, psys->part->from, pa, hairmat);
+    if (psys_child_parent_data_cached(ctx, edit, cpa->pa[0])) {
+      copy_m4_m4(hairmat, ctx->parent_hairmat[cpa->pa[0]]);
+    }
+    else {
+      psys_mat_hair_to_global(ob, ctx->sim.psmd->mesh_final, psys->part->from, pa, hairmat);
+    }
   }
   else {
     ParticleData *pa = psys->particles + cpa->parent;
@@ -2698,7 +2735,12 @@ static void psys_thread_create_path(ParticleTask *task,
                              0,
                              orco);
 
-    psys_mat_hair_to_global(ob, ctx->sim.psmd->mesh_final, psys->part->from, pa, hairmat);
+    if (psys_child_parent_data_cached(ctx, edit, cpa->parent)) {
+      copy_m4_m4(hairmat, ctx->parent_hairmat[cpa->parent]);
+    }
+    else {
+      psys_mat_hair_to_global(ob, ctx->sim.psmd->mesh_final, psys->part->from, pa, hairmat);
+    }
   }
 
   child_keys->segments = ctx->segments;
@@ -2794,7 +2836,6 @@ static void psys_thread_create_path(ParticleTask *task,
   {
     ParticleData *pa = NULL;
     ParticleCacheKey *par = NULL;
-    float par_co[3];
     float par_orco[3];
 
     if (ctx->totparent) {
@@ -2827,17 +2868,12 @@ static void psys_thread_create_path(ParticleTask *task,
       ListBase modifiers;
       BLI_listbase_clear(&modifiers);
 
-      psys_particle_on_emitter(ctx->sim.psmd,
-                               part->from,
-                               pa->num,
-                               pa->num_dmcache,
-                               pa->fuv,
-                               pa->foffset,
-                               par_co,
-                               NULL,
-                               NULL,
-                               NULL,
-                               par_orco);
+      if (psys_child_parent_data_cached(ctx, edit, (int)(pa - psys->particles))) {
+        copy_v3_v3(par_orco, ctx->parent_orco[pa - psys->particles]);
+      }
+      else {
+        psys_child_parent_orco(ctx, pa, par_orco);
+      }
 
       psys_apply_child_modifiers(
           ctx, &modifiers, cpa, &ptex, orco, hairmat, child_keys, par, par_orco);
@@ -2853,6 +2889,40 @@ static void psys_thread_create_path(ParticleTask *task,
   }
 }
 
+static void psys_cache_child_parent_data_cb(void *__restrict userdata,
+                                            const int p,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ParticleThreadContext *ctx = userdata;
+  ParticleSystem *psys = ctx->sim.psys;
+  ParticleData *pa = &psys->particles[p];
+
+  if (!psys_child_parent_data_cached(ctx, psys_orig_edit_get(psys), p)) {
+    return;
+  }
+
+  psys_mat_hair_to_global(
+      ctx->sim.ob, ctx->sim.psmd->mesh_final, psys->part->from, pa, ctx->parent_hairmat[p]);
+  psys_child_parent_orco(ctx, pa, ctx->parent_orco[p]);
+}
+
+/* The hair matrix and original coordinates of a parent are the same for all its children,
+ * compute them once per parent instead of once per child. Entries of parents which aren't cached,
+ * see #psys_child_parent_data_cached, are left uninitialized. */
+static void psys_cache_child_parent_data(ParticleThreadContext *ctx)
+{
+  ParticleSystem *psys = ctx->sim.psys;
+  const int totpart = psys->totpart;
+
+  ctx->parent_hairmat = MEM_malloc_arrayN(totpart, sizeof(*ctx->parent_hairmat), __func__);
+  ctx->parent_orco = MEM_malloc_arrayN(totpart, sizeof(*ctx->parent_orco), __func__);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, totpart, ctx, psys_cache_child_parent_data_cb, &settings);
+}
+
 static void exec_child_path_cache(TaskPool *__restrict UNUSED(pool), void *taskdata)
 {
   ParticleTask *task = taskdata;
@@ -2916,6 +2986,10 @@ void psys_cache_child_paths(ParticleSimulationData *sim,
   }
   BLI_task_pool_work_and_wait(task_pool);
 
+  if (totchild > totparent && sim->psys->totpart > 0) {
+    psys_cache_child_parent_data(&ctx);
+  }
+
   /* cache child paths */
   ctx.parent_pass = 0;
   psys_tasks_create(&ctx, totparent, totchild, &tasks_child, &numtasks_child);
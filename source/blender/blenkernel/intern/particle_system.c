@@ -532,6 +532,8 @@ void psys_thread_context_free(ParticleThreadContext *ctx)
   if (ctx->vg_twist) {
     MEM_freeN(ctx->vg_twist);
   }
+  MEM_SAFE_FREE(ctx->parent_hairmat);
+  MEM_SAFE_FREE(ctx->parent_orco);
 
   if (ctx->sim.psys->lattice_deform_data) {
     BKE_lattice_deform_data_destroy(ctx->sim.psys->lattice_deform_data);
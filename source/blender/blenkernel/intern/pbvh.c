@@ -252,16 +252,19 @@ void pbvh_grow_nodes(PBVH *pbvh, int totnode)
 
 /* Add a vertex to the map, with a positive value for unique vertices and
  * a negative value for additional vertices */
-static int map_insert_vert(
-    PBVH *pbvh, GHash *map, unsigned int *face_verts, unsigned int *uniq_verts, int vertex)
+static int map_insert_vert(PBVH *pbvh,
+                           GHash *map,
+                           unsigned int *face_verts,
+                           unsigned int *uniq_verts,
+                           int node_index,
+                           int vertex)
 {
   void *key, **value_p;
 
   key = POINTER_FROM_INT(vertex);
   if (!BLI_ghash_ensure_p(map, key, &value_p)) {
     int value_i;
-    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, vertex) == 0) {
-      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, vertex);
+    if (pbvh->vert_owner[vertex] == node_index) {
       value_i = *uniq_verts;
       (*uniq_verts)++;
     }
@@ -277,7 +280,7 @@ static int map_insert_vert(
 }
 
 /* Find vertices used by the faces in this node and update the draw buffers */
-static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
+static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node, int node_index)
 {
   bool has_visible = false;
 
@@ -299,7 +302,7 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
     const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
     for (int j = 0; j < 3; j++) {
       face_vert_indices[i][j] = map_insert_vert(
-          pbvh, map, &node->face_verts, &node->uniq_verts, pbvh->mloop[lt->tri[j]].v);
+          pbvh, map, &node->face_verts, &node->uniq_verts, node_index, pbvh->mloop[lt->tri[j]].v);
     }
 
     if (has_visible == false) {
@@ -423,14 +426,64 @@ static void build_leaf(PBVH *pbvh, int node_index, BBC *prim_bbc, int offset, in
   /* Still need vb for searches */
   update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
 
+  /* Vertex indices and visibility are filled in by #pbvh_build_leaf_nodes once the
+   * whole tree is known, so that all leaves can be processed in parallel. */
+}
+
+static void pbvh_build_leaf_node_task_cb(void *__restrict userdata,
+                                         const int n,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVH *pbvh = userdata;
+  PBVHNode *node = &pbvh->nodes[n];
+
+  if (!(node->flag & PBVH_Leaf)) {
+    return;
+  }
+
   if (pbvh->looptri) {
-    build_mesh_leaf_node(pbvh, pbvh->nodes + node_index);
+    build_mesh_leaf_node(pbvh, node, n);
   }
   else {
-    build_grid_leaf_node(pbvh, pbvh->nodes + node_index);
+    build_grid_leaf_node(pbvh, node);
+  }
+}
+
+/* Each vertex is owned by the lowest index leaf node using it, the same result as building
+ * the leaves one after another. Resolving this up front keeps the node contents independent
+ * of the order in which the parallel leaf build runs. */
+static void pbvh_assign_vert_owners(PBVH *pbvh)
+{
+  for (int n = 0; n < pbvh->totnode; n++) {
+    const PBVHNode *node = &pbvh->nodes[n];
+    if (!(node->flag & PBVH_Leaf)) {
+      continue;
+    }
+    for (int i = 0; i < node->totprim; i++) {
+      const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
+      for (int j = 0; j < 3; j++) {
+        const int vertex = pbvh->mloop[lt->tri[j]].v;
+        if (pbvh->vert_owner[vertex] == -1) {
+          pbvh->vert_owner[vertex] = n;
+        }
+      }
+    }
   }
 }
 
+static void pbvh_build_leaf_nodes(PBVH *pbvh)
+{
+  if (pbvh->looptri) {
+    pbvh_assign_vert_owners(pbvh);
+  }
+
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, pbvh->totnode);
+  /* Leaf sizes vary a lot (material splits), balance the work dynamically. */
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, pbvh->totnode, pbvh, pbvh_build_leaf_node_task_cb, &settings);
+}
+
 /* Return zero if all primitives in the node can be drawn with the
  * same material (including flat/smooth shading), non-zero otherwise */
 static bool leaf_needs_material_split(PBVH *pbvh, int offset, int count)
@@ -465,6 +518,118 @@ static bool leaf_needs_material_split(PBVH *pbvh, int offset, int count)
   return false;
 }
 
+/* Number of bins used to evaluate split candidates with the surface area heuristic. */
+#define PBVH_SAH_BINS 16
+
+typedef struct PBVHSAHBin {
+  BB bb;
+  int count;
+} PBVHSAHBin;
+
+BLI_INLINE int sah_bin_index(const float co, const float bmin, const float scale)
+{
+  return clamp_i((int)((co - bmin) * scale), 0, PBVH_SAH_BINS - 1);
+}
+
+static float BB_half_area(const BB *bb)
+{
+  const float dx = bb->bmax[0] - bb->bmin[0];
+  const float dy = bb->bmax[1] - bb->bmin[1];
+  const float dz = bb->bmax[2] - bb->bmin[2];
+  return dx * dy + dy * dz + dz * dx;
+}
+
+/* Find the cheapest split of the primitives according to the surface area heuristic,
+ * evaluated over #PBVH_SAH_BINS equally sized bins of the centroid bounds on each axis.
+ *
+ * Returns false when no split separating the primitives was found. */
+static bool sah_find_split(
+    PBVH *pbvh, const BB *cb, BBC *prim_bbc, int offset, int count, int *r_axis, int *r_bin)
+{
+  float best_cost = FLT_MAX;
+  bool found = false;
+
+  for (int axis = 0; axis < 3; axis++) {
+    const float extent = cb->bmax[axis] - cb->bmin[axis];
+    if (!(extent > 0.0f)) {
+      continue;
+    }
+    const float scale = PBVH_SAH_BINS / extent;
+
+    PBVHSAHBin bins[PBVH_SAH_BINS];
+    for (int b = 0; b < PBVH_SAH_BINS; b++) {
+      BB_reset(&bins[b].bb);
+      bins[b].count = 0;
+    }
+
+    for (int i = offset + count - 1; i >= offset; i--) {
+      BBC *bbc = &prim_bbc[pbvh->prim_indices[i]];
+      PBVHSAHBin *bin = &bins[sah_bin_index(bbc->bcentroid[axis], cb->bmin[axis], scale)];
+      BB_expand_with_bb(&bin->bb, (BB *)bbc);
+      bin->count++;
+    }
+
+    /* Sweep from the right to get the cost of everything above each split plane. */
+    float right_cost[PBVH_SAH_BINS];
+    BB right_bb;
+    int right_count = 0;
+    BB_reset(&right_bb);
+    for (int b = PBVH_SAH_BINS - 1; b > 0; b--) {
+      BB_expand_with_bb(&right_bb, &bins[b].bb);
+      right_count += bins[b].count;
+      right_cost[b] = right_count ? BB_half_area(&right_bb) * right_count : 0.0f;
+    }
+
+    BB left_bb;
+    int left_count = 0;
+    BB_reset(&left_bb);
+    for (int b = 0; b < PBVH_SAH_BINS - 1; b++) {
+      BB_expand_with_bb(&left_bb, &bins[b].bb);
+      left_count += bins[b].count;
+      if (left_count == 0 || left_count == count) {
+        continue;
+      }
+      const float cost = BB_half_area(&left_bb) * left_count + right_cost[b + 1];
+      if (cost < best_cost) {
+        best_cost = cost;
+        *r_axis = axis;
+        *r_bin = b;
+        found = true;
+      }
+    }
+  }
+
+  return found;
+}
+
+/* Returns the index of the first element on the right of the partition,
+ * primitives in bins up to and including split_bin go to the left. */
+static int partition_indices_sah(PBVH *pbvh,
+                                 BBC *prim_bbc,
+                                 const BB *cb,
+                                 int lo,
+                                 int hi,
+                                 int axis,
+                                 int split_bin)
+{
+  int *prim_indices = pbvh->prim_indices;
+  const float scale = PBVH_SAH_BINS / (cb->bmax[axis] - cb->bmin[axis]);
+  int i = lo, j = hi;
+
+  while (i <= j) {
+    const float co = prim_bbc[prim_indices[i]].bcentroid[axis];
+    if (sah_bin_index(co, cb->bmin[axis], scale) <= split_bin) {
+      i++;
+    }
+    else {
+      SWAP(int, prim_indices[i], prim_indices[j]);
+      j--;
+    }
+  }
+
+  return i;
+}
+
 /* Recursively build a node in the tree
  *
  * vb is the voxel box around all of the primitives contained in
@@ -498,7 +663,7 @@ static void build_sub(PBVH *pbvh, int node_index, BB *cb, BBC *prim_bbc, int off
   update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
 
   if (!below_leaf_limit) {
-    /* Find axis with widest range of primitive centroids */
+    /* Find the cheapest split of the primitive centroids */
     if (!cb) {
       cb = &cb_backing;
       BB_reset(cb);
@@ -506,15 +671,21 @@ static void build_sub(PBVH *pbvh, int node_index, BB *cb, BBC *prim_bbc, int off
         BB_expand(cb, prim_bbc[pbvh->prim_indices[i]].bcentroid);
       }
     }
-    const int axis = BB_widest_axis(cb);
-
-    /* Partition primitives along that axis */
-    end = partition_indices(pbvh->prim_indices,
-                            offset,
-                            offset + count - 1,
-                            axis,
-                            (cb->bmax[axis] + cb->bmin[axis]) * 0.5f,
-                            prim_bbc);
+    int axis, split_bin;
+    if (sah_find_split(pbvh, cb, prim_bbc, offset, count, &axis, &split_bin)) {
+      end = partition_indices_sah(
+          pbvh, prim_bbc, cb, offset, offset + count - 1, axis, split_bin);
+    }
+    else {
+      /* Degenerate centroid bounds, fall back to the widest axis midpoint. */
+      axis = BB_widest_axis(cb);
+      end = partition_indices(pbvh->prim_indices,
+                              offset,
+                              offset + count - 1,
+                              axis,
+                              (cb->bmax[axis] + cb->bmin[axis]) * 0.5f,
+                              prim_bbc);
+    }
   }
   else {
     /* Partition primitives by material */
@@ -554,6 +725,7 @@ static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
 
   pbvh->totnode = 1;
   build_sub(pbvh, 0, cb, prim_bbc, 0, totprim);
+  pbvh_build_leaf_nodes(pbvh);
 }
 
 /**
@@ -583,7 +755,8 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   pbvh->mloop = mloop;
   pbvh->looptri = looptri;
   pbvh->verts = verts;
-  pbvh->vert_bitmap = BLI_BITMAP_NEW(totvert, "bvh->vert_bitmap");
+  pbvh->vert_owner = MEM_malloc_arrayN(totvert, sizeof(int), "bvh->vert_owner");
+  copy_vn_i(pbvh->vert_owner, totvert, -1);
   pbvh->totvert = totvert;
   pbvh->leaf_limit = LEAF_LIMIT;
   pbvh->vdata = vdata;
@@ -619,7 +792,7 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   }
 
   MEM_freeN(prim_bbc);
-  MEM_freeN(pbvh->vert_bitmap);
+  MEM_freeN(pbvh->vert_owner);
 }
 
 /* Do a full rebuild with on Grids data structure */
@@ -152,7 +152,8 @@ struct PBVH {
 
   /* Only used during BVH build and update,
    * don't need to remain valid after */
-  BLI_bitmap *vert_bitmap;
+  /* Lowest leaf node index using each vertex, -1 when unused. */
+  int *vert_owner;
 
 #ifdef PERFCNTRS
   int perf_modified;
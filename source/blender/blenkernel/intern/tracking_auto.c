@@ -38,6 +38,8 @@
 #include "BKE_movieclip.h"
 #include "BKE_tracking.h"
 
+#include "IMB_imbuf.h"
+
 #include "libmv-capi.h"
 #include "tracking_private.h"
 
@@ -80,9 +82,24 @@ typedef struct AutoTrackContext {
   bool first_sync;
   SpinLock spin_lock;
 
+  /* Decodes frames ahead of the tracking, so that the footage is read from
+   * disk while the markers of the current frame are being tracked. */
+  TaskPool *prefetch_pool;
+  /* Movie handle of the prefetch, separate from the one of the clip, so that decoding does not
+   * need to hold the movie clip lock which the tracking needs to access frames. */
+  struct anim *prefetch_anim;
+  /* Set when a frame could not be prefetched, in which case the tracking reads it itself. */
+  bool prefetch_stop;
+  int clip_duration;
+
   bool step_ok;
 } AutoTrackContext;
 
+typedef struct AutoTrackPrefetchData {
+  MovieClip *clip;
+  MovieClipUser user;
+} AutoTrackPrefetchData;
+
 static void normalized_to_libmv_frame(const float normalized[2],
                                       const int frame_dimensions[2],
                                       float result[2])
@@ -357,6 +374,8 @@ AutoTrackContext *BKE_autotrack_context_new(MovieClip *clip,
   context->sync_frame = user->framenr;
   context->first_sync = true;
   BLI_spin_init(&context->spin_lock);
+  context->prefetch_pool = BLI_task_pool_create_background(context, TASK_PRIORITY_LOW);
+  context->clip_duration = BKE_movieclip_get_duration(clip);
   const int num_total_tracks = BLI_listbase_count(tracksbase);
   context->tracks = MEM_callocN(sizeof(MovieTrackingTrack *) * num_total_tracks,
                                 "auto track pointers");
@@ -439,11 +458,42 @@ static void autotrack_context_step_cb(void *__restrict userdata,
   atomic_fetch_and_or_uint8((uint8_t *)&context->step_ok, true);
 }
 
+static void autotrack_context_prefetch_cb(TaskPool *__restrict pool, void *taskdata)
+{
+  AutoTrackContext *context = BLI_task_pool_user_data(pool);
+  AutoTrackPrefetchData *data = taskdata;
+  /* Only one frame is prefetched at a time, so the movie handle is not shared. */
+  if (!BKE_movieclip_prefetch_frame(data->clip, &data->user, &context->prefetch_anim)) {
+    context->prefetch_stop = true;
+  }
+}
+
+/* Start decoding of the given scene frame into the movie clip cache in a background thread. */
+static void autotrack_context_prefetch_frame(AutoTrackContext *context, const int framenr)
+{
+  MovieClip *clip = context->clips[0];
+  const int clip_framenr = BKE_movieclip_remap_scene_to_clip_frame(clip, framenr);
+  if (context->prefetch_stop || clip_framenr < 1 || clip_framenr > context->clip_duration) {
+    return;
+  }
+  AutoTrackPrefetchData *data = MEM_mallocN(sizeof(*data), "autotrack prefetch data");
+  data->clip = clip;
+  data->user = context->user;
+  data->user.framenr = framenr;
+  BLI_task_pool_push(context->prefetch_pool, autotrack_context_prefetch_cb, data, true, NULL);
+}
+
 bool BKE_autotrack_context_step(AutoTrackContext *context)
 {
   const int frame_delta = context->backwards ? -1 : 1;
   context->step_ok = false;
 
+  /* Markers are tracked from the current frame to the next one, so decode the frame after that
+   * while this step is running. Tracking itself reads frames through the same cache, so the
+   * result does not depend on whether the prefetch finished in time. */
+  BLI_task_pool_work_and_wait(context->prefetch_pool);
+  autotrack_context_prefetch_frame(context, context->user.framenr + 2 * frame_delta);
+
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
   settings.use_threading = (context->num_tracks > 1);
@@ -539,6 +589,11 @@ void BKE_autotrack_context_finish(AutoTrackContext *context)
 
 void BKE_autotrack_context_free(AutoTrackContext *context)
 {
+  BLI_task_pool_work_and_wait(context->prefetch_pool);
+  BLI_task_pool_free(context->prefetch_pool);
+  if (context->prefetch_anim) {
+    IMB_free_anim(context->prefetch_anim);
+  }
   libmv_autoTrackDestroy(context->autotrack);
   tracking_image_accessor_destroy(context->image_accessor);
   MEM_freeN(context->options);
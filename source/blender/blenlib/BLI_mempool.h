@@ -83,6 +83,9 @@ enum {
    * order of allocation when no chunks have been freed.
    */
   BLI_MEMPOOL_ALLOW_ITER = (1 << 0),
+  /** Allow allocating and freeing elements from multiple threads,
+   * through a #BLI_mempool_local for each thread. */
+  BLI_MEMPOOL_ALLOW_THREADS = (1 << 1),
 };
 
 void BLI_mempool_iternew(BLI_mempool *pool, BLI_mempool_iter *iter) ATTR_NONNULL();
@@ -93,6 +96,22 @@ BLI_mempool_iter *BLI_mempool_iter_threadsafe_create(BLI_mempool *pool,
     ATTR_NONNULL();
 void BLI_mempool_iter_threadsafe_free(BLI_mempool_iter *iter_arr) ATTR_NONNULL();
 
+/** Per-thread cache of free elements, for pools using #BLI_MEMPOOL_ALLOW_THREADS.
+ * private structure, can be stored in task TLS data. */
+typedef struct BLI_mempool_local {
+  BLI_mempool *pool;
+  void *free;
+  unsigned int free_len;
+} BLI_mempool_local;
+
+void BLI_mempool_local_init(BLI_mempool *pool, BLI_mempool_local *local) ATTR_NONNULL();
+void *BLI_mempool_local_alloc(BLI_mempool_local *local) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+void *BLI_mempool_local_calloc(BLI_mempool_local *local) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+void BLI_mempool_local_free(BLI_mempool_local *local, void *addr) ATTR_NONNULL(1, 2);
+void BLI_mempool_local_flush(BLI_mempool_local *local) ATTR_NONNULL();
+
 #ifdef __cplusplus
 }
 #endif
@@ -1076,6 +1076,15 @@ float BLI_bvhtree_get_epsilon(const BVHTree *tree)
   return tree->epsilon;
 }
 
+/**
+ * Change the inflation of the bounding volumes,
+ * only takes effect for nodes updated with #BLI_bvhtree_update_node() afterwards.
+ */
+void BLI_bvhtree_set_epsilon(BVHTree *tree, float epsilon)
+{
+  tree->epsilon = max_ff(FLT_EPSILON, epsilon);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
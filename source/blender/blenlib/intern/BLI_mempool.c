@@ -27,6 +27,8 @@
  * - Freeing chunks.
  * - Iterating over allocated chunks
  *   (optionally when using the #BLI_MEMPOOL_ALLOW_ITER flag).
+ * - Allocating from multiple threads through per-thread caches
+ *   (optionally when using the #BLI_MEMPOOL_ALLOW_THREADS flag).
  */
 
 #include <stdlib.h>
@@ -37,6 +39,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_mempool.h" /* own include */
+#include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -129,8 +132,10 @@ struct BLI_mempool {
   BLI_freenode *free;
   /** Use to know how many chunks to keep for #BLI_mempool_clear. */
   uint maxchunks;
-  /** Number of elements currently in use. */
+  /** Number of elements currently in use (including the ones cached by #BLI_mempool_local). */
   uint totused;
+  /** Protects the free list and chunks when using #BLI_MEMPOOL_ALLOW_THREADS. */
+  SpinLock lock;
 #ifdef USE_TOTALLOC
   /** Number of elements allocated in total. */
   uint totalloc;
@@ -316,6 +321,10 @@ BLI_mempool *BLI_mempool_create(uint esize, uint totelem, uint pchunk, uint flag
 #endif
   pool->totused = 0;
 
+  if (flag & BLI_MEMPOOL_ALLOW_THREADS) {
+    BLI_spin_init(&pool->lock);
+  }
+
   if (totelem) {
     /* Allocate the actual chunks. */
     for (i = 0; i < maxchunks; i++) {
@@ -451,6 +460,173 @@ void BLI_mempool_free(BLI_mempool *pool, void *addr)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Thread Local Caches
+ *
+ * Elements are moved between the pool and the per-thread caches in batches, so the pool only
+ * has to be locked once every few allocations. Cached elements count as used by the pool.
+ * \{ */
+
+BLI_INLINE uint mempool_local_batch(const BLI_mempool *pool)
+{
+  return MAX2(pool->pchunk / 4, 1u);
+}
+
+/**
+ * Initialize a per-thread cache of \a pool, which must use #BLI_MEMPOOL_ALLOW_THREADS.
+ * Elements allocated from one cache may be freed through another one.
+ *
+ * \note #BLI_mempool_local_flush must be called before the pool is used directly again
+ * (iterating, #BLI_mempool_len, #BLI_mempool_alloc...).
+ */
+void BLI_mempool_local_init(BLI_mempool *pool, BLI_mempool_local *local)
+{
+  BLI_assert(pool->flag & BLI_MEMPOOL_ALLOW_THREADS);
+
+  local->pool = pool;
+  local->free = NULL;
+  local->free_len = 0;
+}
+
+static void mempool_local_refill(BLI_mempool_local *local)
+{
+  BLI_mempool *pool = local->pool;
+  const uint batch = mempool_local_batch(pool);
+
+  BLI_spin_lock(&pool->lock);
+
+  if (pool->free == NULL) {
+    /* Don't hold the lock while allocating, other threads may give elements back meanwhile. */
+    BLI_spin_unlock(&pool->lock);
+    BLI_mempool_chunk *mpchunk = mempool_chunk_alloc(pool);
+    BLI_spin_lock(&pool->lock);
+
+    BLI_freenode *free_prev = pool->free;
+    pool->free = NULL;
+    BLI_freenode *last_tail = mempool_chunk_add(pool, mpchunk, NULL);
+    last_tail->next = free_prev;
+  }
+
+  /* Take the first elements of the free list, keeping their order. */
+  BLI_freenode *head = pool->free, *tail = head;
+  uint len = 1;
+  while (len < batch && tail->next) {
+    tail = tail->next;
+    len++;
+  }
+  pool->free = tail->next;
+  tail->next = NULL;
+  pool->totused += len;
+
+  BLI_spin_unlock(&pool->lock);
+
+  local->free = head;
+  local->free_len = len;
+}
+
+/* Give the first \a len cached elements back to the pool. */
+static void mempool_local_release(BLI_mempool_local *local, uint len)
+{
+  BLI_mempool *pool = local->pool;
+  BLI_freenode *head = local->free, *tail = head;
+
+  BLI_assert(len > 0 && len <= local->free_len);
+  for (uint i = 1; i < len; i++) {
+    tail = tail->next;
+  }
+  local->free = tail->next;
+  local->free_len -= len;
+
+  BLI_spin_lock(&pool->lock);
+  tail->next = pool->free;
+  pool->free = head;
+  pool->totused -= len;
+  BLI_spin_unlock(&pool->lock);
+}
+
+void *BLI_mempool_local_alloc(BLI_mempool_local *local)
+{
+  BLI_mempool *pool = local->pool;
+
+  if (UNLIKELY(local->free == NULL)) {
+    mempool_local_refill(local);
+  }
+
+  BLI_freenode *free_pop = local->free;
+
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+    free_pop->freeword = USEDWORD;
+  }
+
+  local->free = free_pop->next;
+  local->free_len--;
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_ALLOC(pool, free_pop, pool->esize);
+#endif
+
+  return (void *)free_pop;
+}
+
+void *BLI_mempool_local_calloc(BLI_mempool_local *local)
+{
+  void *retval = BLI_mempool_local_alloc(local);
+  memset(retval, 0, (size_t)local->pool->esize);
+  return retval;
+}
+
+/**
+ * Free an element into the thread cache, the element may have been allocated by any thread.
+ *
+ * \note doesn't protect against double frees, take care!
+ */
+void BLI_mempool_local_free(BLI_mempool_local *local, void *addr)
+{
+  BLI_mempool *pool = local->pool;
+  BLI_freenode *newhead = addr;
+
+#ifndef NDEBUG
+  /* Enable for debugging. */
+  if (UNLIKELY(mempool_debug_memset)) {
+    memset(addr, 255, pool->esize);
+  }
+#endif
+
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+#ifndef NDEBUG
+    /* This will detect double free's. */
+    BLI_assert(newhead->freeword != FREEWORD);
+#endif
+    newhead->freeword = FREEWORD;
+  }
+
+  newhead->next = local->free;
+  local->free = newhead;
+  local->free_len++;
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_FREE(pool, addr);
+#endif
+
+  /* Don't let a thread which mostly frees keep all the memory to itself. */
+  const uint batch = mempool_local_batch(pool);
+  if (UNLIKELY(local->free_len > batch * 2)) {
+    mempool_local_release(local, batch);
+  }
+}
+
+/**
+ * Give all cached free elements back to the pool, the cache can still be used afterwards.
+ */
+void BLI_mempool_local_flush(BLI_mempool_local *local)
+{
+  if (local->free_len) {
+    mempool_local_release(local, local->free_len);
+  }
+}
+
+/** \} */
+
 int BLI_mempool_len(BLI_mempool *pool)
 {
   return (int)pool->totused;
@@ -758,6 +934,10 @@ void BLI_mempool_destroy(BLI_mempool *pool)
 {
   mempool_chunk_free_all(pool->chunks);
 
+  if (pool->flag & BLI_MEMPOOL_ALLOW_THREADS) {
+    BLI_spin_end(&pool->lock);
+  }
+
 #ifdef WITH_MEM_VALGRIND
   VALGRIND_DESTROY_MEMPOOL(pool);
 #endif
@@ -22,6 +22,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_strict_flags.h"
 #include "BLI_utildefines.h"
 
@@ -58,6 +59,11 @@ struct KDTree {
 
 #define KD_NODE_UNSET ((uint)-1)
 
+/* Sub-trees with more nodes than this are balanced in their own task. */
+#define KD_BALANCE_TASK_MIN 8192
+/* Minimum number of points per thread for batched queries. */
+#define KD_BATCH_QUERY_MIN 256
+
 /**
  * When set we know all values are unbalanced,
  * otherwise clear them when re-balancing: see T62210.
@@ -145,7 +151,47 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+typedef struct KDTreeBalanceTaskData {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+} KDTreeBalanceTaskData;
+
+static uint kdtree_balance(
+    KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs, TaskPool *pool);
+
+static void kdtree_balance_task_cb(TaskPool *__restrict pool, void *taskdata)
+{
+  KDTreeBalanceTaskData *data = taskdata;
+  kdtree_balance(data->nodes, data->nodes_len, data->axis, data->ofs, pool);
+}
+
+/**
+ * Balance a sub-tree, in a new task of \a pool (when not NULL) if it is big enough.
+ *
+ * The root of a balanced sub-tree is always its median, so its index is known before the
+ * sub-tree is actually balanced.
+ */
+static uint kdtree_balance_subtree(
+    KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs, TaskPool *pool)
+{
+  if (pool == NULL || nodes_len < KD_BALANCE_TASK_MIN) {
+    return kdtree_balance(nodes, nodes_len, axis, ofs, pool);
+  }
+
+  KDTreeBalanceTaskData *data = MEM_mallocN(sizeof(*data), __func__);
+  data->nodes = nodes;
+  data->nodes_len = nodes_len;
+  data->axis = axis;
+  data->ofs = ofs;
+  BLI_task_pool_push(pool, kdtree_balance_task_cb, data, true, NULL);
+
+  return (nodes_len / 2) + ofs;
+}
+
+static uint kdtree_balance(
+    KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs, TaskPool *pool)
 {
   KDTreeNode *node;
   float co;
@@ -194,9 +240,9 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   node = &nodes[median];
   node->d = axis;
   axis = (axis + 1) % KD_DIMS;
-  node->left = kdtree_balance(nodes, median, axis, ofs);
-  node->right = kdtree_balance(
-      nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+  node->left = kdtree_balance_subtree(nodes, median, axis, ofs, pool);
+  node->right = kdtree_balance_subtree(
+      nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs, pool);
 
   return median + ofs;
 }
@@ -210,7 +256,16 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len < KD_BALANCE_TASK_MIN * 2) {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0, NULL);
+  }
+  else {
+    /* Both halves of a node are independent, balance big ones in parallel. */
+    TaskPool *pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0, pool);
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  }
 
 #ifdef DEBUG
   tree->is_balanced = true;
@@ -731,6 +786,100 @@ int BLI_kdtree_nd_(range_search)(const KDTree *tree,
   return BLI_kdtree_nd_(range_search_with_len_squared_cb)(tree, co, r_nearest, range, NULL, NULL);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Queries
+ *
+ * Run the same query for many points in parallel,
+ * each query uses its own search stack so no locking is needed.
+ * \{ */
+
+typedef struct KDTreeBatchQueryData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  float range;
+  int *r_index;
+  KDTreeNearest *r_nearest;
+  KDTreeNearest **r_nearest_array;
+  int *r_nearest_len;
+} KDTreeBatchQueryData;
+
+static void kdtree_find_nearest_batch_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  KDTreeBatchQueryData *data = userdata;
+  const int index = BLI_kdtree_nd_(find_nearest)(
+      data->tree, data->co[i], data->r_nearest ? &data->r_nearest[i] : NULL);
+  if (data->r_index) {
+    data->r_index[i] = index;
+  }
+}
+
+/**
+ * Same as #BLI_kdtree_3d_find_nearest for all \a co_len points in \a co.
+ *
+ * \param r_index: Optional, filled with the nearest index of each point (-1 if none found).
+ * \param r_nearest: Optional, filled with the nearest node of each point.
+ */
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const uint co_len,
+                                        int *r_index,
+                                        KDTreeNearest *r_nearest)
+{
+  KDTreeBatchQueryData data = {
+      .tree = tree,
+      .co = co,
+      .r_index = r_index,
+      .r_nearest = r_nearest,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = KD_BATCH_QUERY_MIN;
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_find_nearest_batch_cb, &settings);
+}
+
+static void kdtree_range_search_batch_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  KDTreeBatchQueryData *data = userdata;
+  data->r_nearest_array[i] = NULL;
+  data->r_nearest_len[i] = BLI_kdtree_nd_(range_search)(
+      data->tree, data->co[i], &data->r_nearest_array[i], data->range);
+}
+
+/**
+ * Same as #BLI_kdtree_3d_range_search for all \a co_len points in \a co.
+ *
+ * \param r_nearest_array: Filled with the (sorted) nodes found around each point,
+ * NULL when none were found, otherwise to be freed by the caller.
+ * \param r_nearest_len: Filled with the number of nodes found around each point.
+ */
+void BLI_kdtree_nd_(range_search_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const uint co_len,
+                                        const float range,
+                                        KDTreeNearest **r_nearest_array,
+                                        int *r_nearest_len)
+{
+  KDTreeBatchQueryData data = {
+      .tree = tree,
+      .co = co,
+      .range = range,
+      .r_nearest_array = r_nearest_array,
+      .r_nearest_len = r_nearest_len,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = KD_BATCH_QUERY_MIN;
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_range_search_batch_cb, &settings);
+}
+
+/** \} */
+
 /**
  * A version of #BLI_kdtree_3d_range_search which runs a callback
  * instead of allocating an array.
@@ -0,0 +1,141 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_kdtree.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.h"
+#include "BLI_task.h"
+
+/* -------------------------------------------------------------------- */
+/* Helper Functions */
+
+static void rng_v3_array(float (*coords)[3], int coords_len, struct RNG *rng)
+{
+  for (int i = 0; i < coords_len; i++) {
+    for (int j = 0; j < 3; j++) {
+      coords[i][j] = BLI_rng_get_float(rng) * 2.0f - 1.0f;
+    }
+  }
+}
+
+static float find_nearest_dist_sq_brute_force(const float (*coords)[3],
+                                              int coords_len,
+                                              const float co[3])
+{
+  float dist_sq_min = FLT_MAX;
+  for (int i = 0; i < coords_len; i++) {
+    dist_sq_min = min_ff(dist_sq_min, len_squared_v3v3(coords[i], co));
+  }
+  return dist_sq_min;
+}
+
+/* -------------------------------------------------------------------- */
+/* Tests */
+
+/* Big enough for the tree to be balanced in parallel. */
+static const int tree_points_len = 100000;
+static const int query_points_len = 1000;
+
+static KDTree_3d *kdtree_random_new(float (*coords)[3], int coords_len, struct RNG *rng)
+{
+  rng_v3_array(coords, coords_len, rng);
+
+  KDTree_3d *tree = BLI_kdtree_3d_new(coords_len);
+  for (int i = 0; i < coords_len; i++) {
+    BLI_kdtree_3d_insert(tree, i, coords[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+  return tree;
+}
+
+TEST(kdtree, Empty)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(0);
+  BLI_kdtree_3d_balance(tree);
+
+  const float co[1][3] = {{0.0f, 0.0f, 0.0f}};
+  int index;
+  BLI_kdtree_3d_find_nearest_batch(tree, co, 1, &index, nullptr);
+  EXPECT_EQ(index, -1);
+
+  BLI_kdtree_3d_free(tree);
+}
+
+TEST(kdtree, FindNearestBatch)
+{
+  BLI_task_scheduler_init();
+
+  RNG *rng = BLI_rng_new(0);
+  float(*coords)[3] = (float(*)[3])MEM_mallocN(sizeof(*coords) * tree_points_len, __func__);
+  float(*query)[3] = (float(*)[3])MEM_mallocN(sizeof(*query) * query_points_len, __func__);
+  int *index = (int *)MEM_mallocN(sizeof(*index) * query_points_len, __func__);
+  KDTreeNearest_3d *nearest = (KDTreeNearest_3d *)MEM_mallocN(
+      sizeof(*nearest) * query_points_len, __func__);
+
+  KDTree_3d *tree = kdtree_random_new(coords, tree_points_len, rng);
+  rng_v3_array(query, query_points_len, rng);
+
+  BLI_kdtree_3d_find_nearest_batch(tree, query, query_points_len, index, nearest);
+
+  for (int i = 0; i < query_points_len; i++) {
+    const float dist_sq = find_nearest_dist_sq_brute_force(coords, tree_points_len, query[i]);
+    EXPECT_EQ(index[i], nearest[i].index);
+    EXPECT_NEAR(len_squared_v3v3(coords[index[i]], query[i]), dist_sq, 1e-6f);
+    EXPECT_EQ(index[i], BLI_kdtree_3d_find_nearest(tree, query[i], nullptr));
+  }
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(coords);
+  MEM_freeN(query);
+  MEM_freeN(index);
+  MEM_freeN(nearest);
+  BLI_rng_free(rng);
+
+  BLI_task_scheduler_exit();
+}
+
+TEST(kdtree, RangeSearchBatch)
+{
+  BLI_task_scheduler_init();
+
+  const float range = 0.05f;
+
+  RNG *rng = BLI_rng_new(0);
+  float(*coords)[3] = (float(*)[3])MEM_mallocN(sizeof(*coords) * tree_points_len, __func__);
+  float(*query)[3] = (float(*)[3])MEM_mallocN(sizeof(*query) * query_points_len, __func__);
+  KDTreeNearest_3d **nearest = (KDTreeNearest_3d **)MEM_mallocN(
+      sizeof(*nearest) * query_points_len, __func__);
+  int *nearest_len = (int *)MEM_mallocN(sizeof(*nearest_len) * query_points_len, __func__);
+
+  KDTree_3d *tree = kdtree_random_new(coords, tree_points_len, rng);
+  rng_v3_array(query, query_points_len, rng);
+
+  BLI_kdtree_3d_range_search_batch(tree, query, query_points_len, range, nearest, nearest_len);
+
+  for (int i = 0; i < query_points_len; i++) {
+    int found_len = 0;
+    for (int j = 0; j < tree_points_len; j++) {
+      if (len_squared_v3v3(coords[j], query[i]) <= range * range) {
+        found_len++;
+      }
+    }
+    EXPECT_EQ(nearest_len[i], found_len);
+    EXPECT_EQ(nearest[i] == nullptr, found_len == 0);
+    for (int j = 1; j < nearest_len[i]; j++) {
+      EXPECT_LE(nearest[i][j - 1].dist, nearest[i][j].dist);
+    }
+    MEM_SAFE_FREE(nearest[i]);
+  }
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(coords);
+  MEM_freeN(query);
+  MEM_freeN(nearest);
+  MEM_freeN(nearest_len);
+  BLI_rng_free(rng);
+
+  BLI_task_scheduler_exit();
+}
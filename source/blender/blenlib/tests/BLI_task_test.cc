@@ -134,6 +134,77 @@ TEST(task, MempoolIter)
   BLI_threadapi_exit();
 }
 
+/* *** Parallel allocations from a mempool. *** */
+
+static void task_mempool_local_alloc_func(void *userdata,
+                                          int index,
+                                          const TaskParallelTLS *__restrict tls)
+{
+  int **data = (int **)userdata;
+  BLI_mempool_local *local = (BLI_mempool_local *)tls->userdata_chunk;
+
+  int *item = (int *)BLI_mempool_local_alloc(local);
+  *item = index;
+
+  /* Free some items again, possibly from another thread than the one which allocated them. */
+  if (index % 3 == 0 && index > 0) {
+    int *item_prev = data[index - 1];
+    if (item_prev && atomic_cas_ptr((void **)&data[index - 1], item_prev, NULL) == item_prev) {
+      BLI_mempool_local_free(local, item_prev);
+    }
+  }
+  data[index] = item;
+}
+
+static void task_mempool_local_free_func(const void *__restrict UNUSED(userdata),
+                                         void *__restrict userdata_chunk)
+{
+  BLI_mempool_local_flush((BLI_mempool_local *)userdata_chunk);
+}
+
+TEST(task, MempoolLocalAlloc)
+{
+  int *data[NUM_ITEMS] = {NULL};
+  BLI_threadapi_init();
+  BLI_mempool *mempool = BLI_mempool_create(
+      sizeof(*data[0]), 0, 32, BLI_MEMPOOL_ALLOW_ITER | BLI_MEMPOOL_ALLOW_THREADS);
+
+  BLI_mempool_local local;
+  BLI_mempool_local_init(mempool, &local);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  settings.userdata_chunk = &local;
+  settings.userdata_chunk_size = sizeof(local);
+  settings.func_free = task_mempool_local_free_func;
+
+  BLI_task_parallel_range(0, NUM_ITEMS, data, task_mempool_local_alloc_func, &settings);
+
+  int num_items = 0;
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    if (data[i] != NULL) {
+      EXPECT_EQ(*data[i], i);
+      num_items++;
+    }
+  }
+  EXPECT_EQ(BLI_mempool_len(mempool), num_items);
+
+  /* Cached elements were given back, iteration only finds the used ones. */
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(mempool, &iter);
+  int num_iter = 0;
+  for (int *item = (int *)BLI_mempool_iterstep(&iter); item;
+       item = (int *)BLI_mempool_iterstep(&iter)) {
+    EXPECT_EQ(data[*item], item);
+    num_iter++;
+  }
+  EXPECT_EQ(num_iter, num_items);
+
+  BLI_mempool_destroy(mempool);
+  BLI_threadapi_exit();
+}
+
 /* *** Parallel iterations over double-linked list items. *** */
 
 static void task_listbase_iter_func(void *userdata,
@@ -444,7 +444,7 @@ static void versions_gpencil_add_main(ListBase *lb, ID *id, const char *name)
   id->flag = LIB_FAKEUSER;
   *((short *)id->name) = ID_GD;
 
-  BKE_id_new_name_validate(lb, id, name);
+  BKE_id_new_name_validate(NULL, lb, id, name);
   /* alphabetic insertion: is in BKE_id_new_name_validate */
 
   BKE_lib_libblock_session_uuid_ensure(id);
@@ -78,6 +78,11 @@ void DEG_graph_relations_update(struct Depsgraph *graph);
 /* Tag all relations in the database for update.*/
 void DEG_relations_tag_update(struct Main *bmain);
 
+/* Tag relations of the given ID for update, in dependency graphs which contain it.
+ * To be used when a change only affects relations built for this ID (adding a modifier or a
+ * constraint to an object). The graphs are patched instead of being rebuilt when possible. */
+void DEG_id_relations_tag_update(struct Main *bmain, struct ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /* Handle for components to define their dependencies from callbacks.
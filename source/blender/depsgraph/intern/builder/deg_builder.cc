@@ -42,6 +42,7 @@
 #include "intern/depsgraph_relation.h"
 #include "intern/depsgraph_tag.h"
 #include "intern/depsgraph_type.h"
+#include "intern/eval/deg_eval.h"
 #include "intern/eval/deg_eval_copy_on_write.h"
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
@@ -209,6 +210,7 @@ void deg_graph_build_finalize(Main *bmain, Depsgraph *graph)
   /* Make sure dependencies of visible ID datablocks are visible. */
   deg_graph_build_flush_visibility(graph);
   deg_graph_remove_unused_noops(graph);
+  deg_graph_sort_relations_by_priority(graph);
 
   /* Re-tag IDs for update if it was tagged before the relations
    * update tag. */
@@ -167,9 +167,13 @@ IDNode *DepsgraphNodeBuilder::add_id_node(ID *id)
     id_info->id_cow = nullptr;
   }
   id_node = graph_->add_id_node(id, id_cow);
-  id_node->previously_visible_components_mask = previously_visible_components_mask;
-  id_node->previous_eval_flags = previous_eval_flags;
-  id_node->previous_customdata_masks = previous_customdata_masks;
+  /* Nodes which are kept from the previous state of the graph when patching it already have
+   * the values of the previous state. */
+  if (id_info != nullptr || id_node->components.is_empty()) {
+    id_node->previously_visible_components_mask = previously_visible_components_mask;
+    id_node->previous_eval_flags = previous_eval_flags;
+    id_node->previous_customdata_masks = previous_customdata_masks;
+  }
   /* Currently all ID nodes are supposed to have copy-on-write logic.
    *
    * NOTE: Zero number of components indicates that ID node was just created. */
@@ -357,6 +361,47 @@ void DepsgraphNodeBuilder::begin_build()
   graph_->entry_tags.clear();
 }
 
+void DepsgraphNodeBuilder::begin_patch(Scene *scene,
+                                       ViewLayer *view_layer,
+                                       const Set<ID *> &ids)
+{
+  /* Same context as build_view_layer(). */
+  view_layer_index_ = 0;
+  scene_ = scene;
+  view_layer_ = view_layer;
+
+  for (IDNode *id_node : graph_->id_nodes) {
+    /* The graph was evaluated in its current state already, only changes caused by the patch
+     * are to be tagged by the finalization. */
+    id_node->previously_visible_components_mask = id_node->visible_components_mask;
+    id_node->previous_eval_flags = id_node->eval_flags;
+    id_node->previous_customdata_masks = id_node->customdata_masks;
+    if (!ids.contains(id_node->id_orig)) {
+      built_map_.tagBuild(id_node->id_orig);
+    }
+  }
+
+  Vector<OperationNode *> patched_entry_tags;
+  for (OperationNode *op_node : graph_->entry_tags) {
+    ComponentNode *comp_node = op_node->owner;
+    IDNode *id_node = comp_node->owner;
+    if (!ids.contains(id_node->id_orig) || comp_node->type == NodeType::COPY_ON_WRITE) {
+      continue;
+    }
+    SavedEntryTag entry_tag;
+    entry_tag.id_orig = id_node->id_orig;
+    entry_tag.component_type = comp_node->type;
+    entry_tag.opcode = op_node->opcode;
+    entry_tag.name = op_node->name;
+    entry_tag.name_tag = op_node->name_tag;
+    saved_entry_tags_.append(entry_tag);
+    patched_entry_tags.append(op_node);
+  }
+  for (OperationNode *op_node : patched_entry_tags) {
+    graph_->entry_tags.remove(op_node);
+  }
+}
+
 void DepsgraphNodeBuilder::end_build()
 {
   for (const SavedEntryTag &entry_tag : saved_entry_tags_) {
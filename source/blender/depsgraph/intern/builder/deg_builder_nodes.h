@@ -101,6 +101,10 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void begin_build();
   virtual void end_build();
 
+  /* Prepare for rebuilding nodes of the given IDs only, keeping the rest of the graph.
+   * Entry tags of the IDs are saved and re-applied by end_build(). */
+  virtual void begin_patch(Scene *scene, ViewLayer *view_layer, const Set<ID *> &ids);
+
   IDNode *add_id_node(ID *id);
   IDNode *find_id_node(ID *id);
   TimeSourceNode *add_time_source();
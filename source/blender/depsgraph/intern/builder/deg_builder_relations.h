@@ -164,6 +164,8 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   DepsgraphRelationBuilder(Main *bmain, Depsgraph *graph, DepsgraphBuilderCache *cache);
 
   void begin_build();
+  /* Prepare for rebuilding relations of the given IDs only, other IDs are not visited. */
+  void begin_patch(Scene *scene, const Set<ID *> &ids);
 
   template<typename KeyFrom, typename KeyTo>
   Relation *add_relation(const KeyFrom &key_from,
@@ -66,9 +66,9 @@ void deg_graph_remove_unused_noops(Depsgraph *graph)
       Relation *rel_in = to_remove->inlinks[0];
       Node *dependency = rel_in->from;
 
-      /* Remove the relation. */
+      /* Remove the relation, it is kept by the graph for patching. */
       rel_in->unlink();
-      delete rel_in;
+      graph->unused_noop_relations.append(rel_in);
       num_removed_relations++;
 
       /* Queue parent no-op node that has now become unused. */
@@ -0,0 +1,286 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+#include "pipeline_patch_ids.h"
+
+#include "PIL_time.h"
+
+#include "BLI_listbase.h"
+
+#include "BKE_global.h"
+
+#include "DNA_layer_types.h"
+#include "DNA_object_types.h"
+
+#include "intern/builder/deg_builder_nodes.h"
+#include "intern/builder/deg_builder_relations.h"
+#include "intern/builder/pipeline_view_layer.h"
+#include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+
+namespace blender {
+namespace deg {
+
+PatchIDsBuilderPipeline::PatchIDsBuilderPipeline(::Depsgraph *graph)
+    : AbstractBuilderPipeline(graph), ids_(deg_graph_->id_relations_update)
+{
+}
+
+void PatchIDsBuilderPipeline::patch()
+{
+  double start_time = 0.0;
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    start_time = PIL_check_seconds_timer();
+  }
+
+  unique_ptr<DepsgraphNodeBuilder> node_builder = construct_node_builder();
+  if (!can_patch(*node_builder)) {
+    build_full();
+    return;
+  }
+
+  /* Remove nodes of the patched IDs. */
+  restore_unused_noop_relations();
+  node_builder->begin_patch(scene_, view_layer_, ids_);
+  for (ID *id : ids_) {
+    clear_id_node(deg_graph_->find_id_node(id));
+  }
+  remove_cleared_operations();
+
+  /* Build them again, IDs which are not in the graph yet are added. */
+  const int64_t num_kept_id_nodes = deg_graph_->id_nodes.size();
+  build_nodes(*node_builder);
+  node_builder->end_build();
+
+  unique_ptr<DepsgraphRelationBuilder> relation_builder = construct_relation_builder();
+  relation_builder->begin_patch(scene_, ids_);
+  build_relations(*relation_builder);
+  for (ID *id : ids_) {
+    IDNode *id_node = deg_graph_->find_id_node(id);
+    relation_builder->build_copy_on_write_relations(id_node);
+    relation_builder->build_driver_relations(id_node);
+  }
+  for (int64_t i = num_kept_id_nodes; i < deg_graph_->id_nodes.size(); i++) {
+    relation_builder->build_copy_on_write_relations(deg_graph_->id_nodes[i]);
+    relation_builder->build_driver_relations(deg_graph_->id_nodes[i]);
+  }
+
+  if (!restore_preserved_relations()) {
+    /* Other IDs depend on an operation which the patched ID does not have anymore, their
+     * relations are to be built again. */
+    build_full();
+    return;
+  }
+
+  build_step_finalize();
+
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    printf("Depsgraph patched in %f seconds.\n", PIL_check_seconds_timer() - start_time);
+  }
+}
+
+void PatchIDsBuilderPipeline::build_nodes(DepsgraphNodeBuilder &node_builder)
+{
+  for (ID *id : ids_) {
+    Object *object = (Object *)id;
+    node_builder.build_object(base_indices_.lookup(object), object, DEG_ID_LINKED_DIRECTLY, true);
+  }
+}
+
+void PatchIDsBuilderPipeline::build_relations(DepsgraphRelationBuilder &relation_builder)
+{
+  for (ID *id : ids_) {
+    relation_builder.build_object((Object *)id);
+  }
+}
+
+bool PatchIDsBuilderPipeline::can_patch(DepsgraphNodeBuilder &node_builder)
+{
+  /* Transitive reduction removes relations which the patch can not restore. */
+  if (G.debug_value == 799 || deg_graph_->is_render_pipeline_depsgraph) {
+    return false;
+  }
+  for (ID *id : ids_) {
+    IDNode *id_node = deg_graph_->find_id_node(id);
+    if (id_node == nullptr || GS(id->name) != ID_OB ||
+        id_node->linked_state != DEG_ID_LINKED_DIRECTLY) {
+      return false;
+    }
+    /* Nodes and relations of these are partially built by other IDs. */
+    Object *object = (Object *)id;
+    if (object->type == OB_ARMATURE || object->proxy != nullptr ||
+        object->proxy_from != nullptr || object->proxy_group != nullptr ||
+        object->rigidbody_object != nullptr || object->rigidbody_constraint != nullptr ||
+        !BLI_listbase_is_empty(&object->particlesystem)) {
+      return false;
+    }
+    /* Same base index as used by the view layer builder. */
+    int base_index = 0;
+    bool has_base = false;
+    LISTBASE_FOREACH (Base *, base, &view_layer_->object_bases) {
+      if (node_builder.need_pull_base_into_graph(base)) {
+        if (base->object == object) {
+          has_base = true;
+          break;
+        }
+        base_index++;
+      }
+    }
+    if (!has_base) {
+      return false;
+    }
+    base_indices_.add(object, base_index);
+    /* Animation and drivers of other IDs writing to the object. */
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      for (OperationNode *op_node : comp_node->operations) {
+        for (Relation *rel : op_node->inlinks) {
+          if (rel->from->type != NodeType::OPERATION) {
+            continue;
+          }
+          OperationNode *op_from = (OperationNode *)rel->from;
+          if (op_from->owner->owner != id_node &&
+              (op_from->owner->type == NodeType::ANIMATION ||
+               op_from->opcode == OperationCode::DRIVER)) {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void PatchIDsBuilderPipeline::build_full()
+{
+  ViewLayerBuilderPipeline builder(reinterpret_cast<::Depsgraph *>(deg_graph_));
+  builder.build();
+}
+
+void PatchIDsBuilderPipeline::restore_unused_noop_relations()
+{
+  /* New relations might start from no-op nodes which are not used by the current graph, those
+   * need their own dependencies back. Unused ones are removed again by the finalization. */
+  for (Relation *rel : deg_graph_->unused_noop_relations) {
+    rel->link();
+  }
+  deg_graph_->unused_noop_relations.clear();
+}
+
+void PatchIDsBuilderPipeline::clear_id_node(IDNode *id_node)
+{
+  ComponentNode *cow_comp_node = nullptr;
+  for (ComponentNode *comp_node : id_node->components.values()) {
+    if (comp_node->type == NodeType::COPY_ON_WRITE) {
+      /* Keep the copy-on-write operation, so that the evaluated ID is kept. Its dependencies
+       * are built again by the copy-on-write relations of the ID. */
+      cow_comp_node = comp_node;
+      for (OperationNode *op_node : comp_node->operations) {
+        while (!op_node->inlinks.is_empty()) {
+          Relation *rel = op_node->inlinks[0];
+          rel->unlink();
+          delete rel;
+        }
+      }
+      continue;
+    }
+    for (OperationNode *op_node : comp_node->operations) {
+      while (!op_node->outlinks.is_empty()) {
+        Relation *rel = op_node->outlinks[0];
+        if (rel->to->type == NodeType::OPERATION) {
+          const IDNode *id_node_to = ((OperationNode *)rel->to)->owner->owner;
+          if (id_node_to != id_node && !ids_.contains(id_node_to->id_orig)) {
+            PreservedRelation preserved_relation;
+            preserved_relation.id_orig = id_node->id_orig;
+            preserved_relation.component_type = comp_node->type;
+            preserved_relation.component_name = comp_node->name;
+            preserved_relation.opcode = op_node->opcode;
+            preserved_relation.name = op_node->name;
+            preserved_relation.name_tag = op_node->name_tag;
+            preserved_relation.to = rel->to;
+            preserved_relation.description = rel->name;
+            preserved_relation.flag = rel->flag & ~RELATION_FLAG_CYCLIC;
+            preserved_relations_.append(preserved_relation);
+          }
+        }
+        rel->unlink();
+        delete rel;
+      }
+      while (!op_node->inlinks.is_empty()) {
+        Relation *rel = op_node->inlinks[0];
+        rel->unlink();
+        delete rel;
+      }
+      cleared_operations_.add(op_node);
+    }
+  }
+  BLI_assert(cow_comp_node != nullptr);
+  for (ComponentNode *comp_node : id_node->components.values()) {
+    if (comp_node != cow_comp_node) {
+      delete comp_node;
+    }
+  }
+  id_node->components.clear();
+  id_node->components.add_new(
+      IDNode::ComponentIDKey(cow_comp_node->type, cow_comp_node->name.c_str()), cow_comp_node);
+}
+
+void PatchIDsBuilderPipeline::remove_cleared_operations()
+{
+  Depsgraph::OperationNodes operations;
+  operations.reserve(deg_graph_->operations.size() - cleared_operations_.size());
+  for (OperationNode *op_node : deg_graph_->operations) {
+    if (!cleared_operations_.contains(op_node)) {
+      operations.append(op_node);
+    }
+  }
+  deg_graph_->operations = std::move(operations);
+  cleared_operations_.clear();
+}
+
+bool PatchIDsBuilderPipeline::restore_preserved_relations()
+{
+  for (const PreservedRelation &preserved_relation : preserved_relations_) {
+    IDNode *id_node = deg_graph_->find_id_node(preserved_relation.id_orig);
+    ComponentNode *comp_node = id_node->find_component(
+        preserved_relation.component_type, preserved_relation.component_name.c_str());
+    if (comp_node == nullptr) {
+      return false;
+    }
+    OperationNode *op_node = comp_node->find_operation(
+        preserved_relation.opcode, preserved_relation.name.c_str(), preserved_relation.name_tag);
+    if (op_node == nullptr) {
+      return false;
+    }
+    /* The relation might have been built again by the patched ID. */
+    if (deg_graph_->check_nodes_connected(op_node, preserved_relation.to, nullptr) != nullptr) {
+      continue;
+    }
+    Relation *rel = deg_graph_->add_new_relation(
+        op_node, preserved_relation.to, preserved_relation.description);
+    rel->flag |= preserved_relation.flag;
+  }
+  preserved_relations_.clear();
+  return true;
+}
+
+}  // namespace deg
+}  // namespace blender
@@ -0,0 +1,93 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+#include "pipeline.h"
+
+#include "intern/node/deg_node.h"
+#include "intern/node/deg_node_operation.h"
+
+struct Object;
+
+namespace blender {
+namespace deg {
+
+struct IDNode;
+struct Relation;
+
+/* Rebuild nodes and relations of the IDs tagged by DEG_id_relations_tag_update(), patching the
+ * existing graph instead of building it from scratch.
+ *
+ * General notes:
+ *
+ * - Only objects which are pulled into the graph by a base of the view layer are patched. When
+ *   other IDs are tagged, or the object gets nodes or relations from builders of other IDs
+ *   (rigid body world, animation of other IDs, rigs and proxies, particle systems), the whole
+ *   graph is rebuilt instead.
+ *
+ * - Relations into the patched IDs are considered to be built by them. Relations from the
+ *   patched IDs to other IDs are kept and re-connected to the rebuilt operations.
+ *
+ * - IDs which are not in the graph yet (new modifier or constraint targets) are built fully.
+ *   IDs which are not used anymore are kept until the next full rebuild. */
+class PatchIDsBuilderPipeline : public AbstractBuilderPipeline {
+ public:
+  PatchIDsBuilderPipeline(::Depsgraph *graph);
+
+  void patch();
+
+ protected:
+  virtual void build_nodes(DepsgraphNodeBuilder &node_builder) override;
+  virtual void build_relations(DepsgraphRelationBuilder &relation_builder) override;
+
+ private:
+  /* Relation from an operation of a patched ID to another ID, identified by keys since the
+   * operation is re-created. */
+  struct PreservedRelation {
+    ID *id_orig;
+    NodeType component_type;
+    string component_name;
+    OperationCode opcode;
+    string name;
+    int name_tag;
+    Node *to;
+    const char *description;
+    int flag;
+  };
+
+  bool can_patch(DepsgraphNodeBuilder &node_builder);
+  void build_full();
+  void restore_unused_noop_relations();
+  void clear_id_node(IDNode *id_node);
+  void remove_cleared_operations();
+  bool restore_preserved_relations();
+
+  Set<ID *> ids_;
+  Map<Object *, int> base_indices_;
+  Set<OperationNode *> cleared_operations_;
+  Vector<PreservedRelation> preserved_relations_;
+};
+
+}  // namespace deg
+}  // namespace blender
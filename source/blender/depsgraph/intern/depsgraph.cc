@@ -163,6 +163,11 @@ void Depsgraph::clear_id_nodes()
   for (IDNode *id_node : id_nodes) {
     delete id_node;
   }
+  /* Relations which are not linked to nodes are not freed with them. */
+  for (Relation *rel : unused_noop_relations) {
+    delete rel;
+  }
+  unused_noop_relations.clear();
   /* Clear containers. */
   id_hash.clear();
   id_nodes.clear();
@@ -111,6 +111,14 @@ struct Depsgraph {
   /* Indicates whether relations needs to be updated. */
   bool need_update;
 
+  /* IDs whose nodes and relations are to be rebuilt, without rebuilding the whole graph.
+   * Not used when `need_update` is set. */
+  Set<ID *> id_relations_update;
+
+  /* Relations to no-op nodes removed by deg_graph_remove_unused_noops(). They are kept so
+   * that the graph can be patched: new relations may start from such no-op nodes. */
+  Vector<Relation *> unused_noop_relations;
+
   /* Indicates which ID types were updated. */
   char id_type_updated[MAX_LIBARRAY];
 
@@ -47,6 +47,7 @@
 #include "builder/pipeline_all_objects.h"
 #include "builder/pipeline_compositor.h"
 #include "builder/pipeline_from_ids.h"
+#include "builder/pipeline_patch_ids.h"
 #include "builder/pipeline_render.h"
 #include "builder/pipeline_view_layer.h"
 
@@ -262,11 +263,16 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
 void DEG_graph_relations_update(Depsgraph *graph)
 {
   deg::Depsgraph *deg_graph = (deg::Depsgraph *)graph;
-  if (!deg_graph->need_update) {
-    /* Graph is up to date, nothing to do. */
+  if (deg_graph->need_update) {
+    DEG_graph_build_from_view_layer(graph);
     return;
   }
-  DEG_graph_build_from_view_layer(graph);
+  if (!deg_graph->id_relations_update.is_empty()) {
+    deg::PatchIDsBuilderPipeline builder(graph);
+    builder.patch();
+    return;
+  }
+  /* Graph is up to date, nothing to do. */
 }
 
 /* Tag all relations for update. */
@@ -277,3 +283,18 @@ void DEG_relations_tag_update(Main *bmain)
     DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
   }
 }
+
+/* Tag relations of the ID for update in graphs which contain it. */
+void DEG_id_relations_tag_update(Main *bmain, ID *id)
+{
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
+    /* Graph which does not contain the ID has no relations built for it. Changes to the ID can
+     * not pull anything new into such graph, since only IDs which are already part of the graph
+     * are visited by the relations builder. */
+    if (depsgraph->need_update || depsgraph->find_id_node(id) == nullptr) {
+      continue;
+    }
+    depsgraph->id_relations_update.add(id);
+  }
+}
@@ -65,5 +65,13 @@ void Relation::unlink()
   to->inlinks.remove_first_occurrence_and_reorder(this);
 }
 
+void Relation::link()
+{
+  /* Sanity check. */
+  BLI_assert(from != nullptr && to != nullptr);
+  from->outlinks.append(this);
+  to->inlinks.append(this);
+}
+
 }  // namespace deg
 }  // namespace blender
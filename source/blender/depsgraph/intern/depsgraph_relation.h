@@ -53,6 +53,8 @@ struct Relation {
   ~Relation();
 
   void unlink();
+  /* Register unlinked relation in the nodes it connects again. */
+  void link();
 
   /* the nodes in the relationship (since this is shared between the nodes) */
   Node *from; /* A */
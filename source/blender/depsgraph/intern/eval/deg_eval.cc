@@ -96,6 +96,8 @@ struct DepsgraphEvalState {
   bool do_stats;
   EvaluationStage stage;
   bool need_single_thread_pass;
+  /* Operations which are tagged for update, sorted by their priority (highest first). */
+  Vector<OperationNode *> scheduled_operations;
 };
 
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
@@ -178,16 +180,113 @@ void calculate_pending_parents(Depsgraph *graph)
   }
 }
 
+/* Check whether the node is to be evaluated as part of the current graph evaluation. */
+bool need_evaluate_operation(OperationNode *node)
+{
+  return (node->flag & DEPSOP_FLAG_NEEDS_UPDATE) && check_operation_node_visible(node);
+}
+
+enum {
+  OPERATION_PRIORITY_NONE = 0,
+  OPERATION_PRIORITY_IN_PROGRESS = 1,
+  OPERATION_PRIORITY_DONE = 2,
+};
+
+double operation_cost(const OperationNode *node)
+{
+  if (node->is_noop()) {
+    return 0.0;
+  }
+  /* Timing is only known when it is measured for debugging (see #deg_eval_stats_update_average).
+   * Otherwise all operations are given a same small cost, so that the amount of operations on the
+   * path is used as an estimate. */
+  return max(node->stats.average_time, 1e-6);
+}
+
+/* Calculate priority of the operation as a cost of the most expensive path from it to any of
+ * the leaf operations. When only_evaluated is true, only operations which are to be evaluated are
+ * taken into account.
+ *
+ * Uses depth-first traversal with an explicit stack, since the chains of operations in
+ * production rigs are too long for recursion. */
+void calculate_priority_for_node(OperationNode *root, const bool only_evaluated)
+{
+  Vector<std::pair<OperationNode *, int64_t>> stack;
+  stack.append({root, 0});
+  root->custom_flags = OPERATION_PRIORITY_IN_PROGRESS;
+  while (!stack.is_empty()) {
+    OperationNode *node = stack.last().first;
+    int64_t &link_index = stack.last().second;
+    bool descended = false;
+    while (link_index < node->outlinks.size()) {
+      Relation *rel = node->outlinks[link_index++];
+      if (rel->flag & RELATION_FLAG_CYCLIC) {
+        continue;
+      }
+      OperationNode *child = (OperationNode *)rel->to;
+      if (child->custom_flags != OPERATION_PRIORITY_NONE ||
+          (only_evaluated && !need_evaluate_operation(child))) {
+        continue;
+      }
+      child->custom_flags = OPERATION_PRIORITY_IN_PROGRESS;
+      stack.append({child, 0});
+      descended = true;
+      break;
+    }
+    if (descended) {
+      continue;
+    }
+    /* All children are handled, calculate priority of the node itself. */
+    double children_priority = 0.0;
+    for (Relation *rel : node->outlinks) {
+      OperationNode *child = (OperationNode *)rel->to;
+      /* Children which are still in progress are part of a dependency cycle which was not
+       * detected by the builder, ignore them. */
+      if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 &&
+          child->custom_flags == OPERATION_PRIORITY_DONE) {
+        children_priority = max(children_priority, child->priority);
+      }
+    }
+    node->priority = operation_cost(node) + children_priority;
+    node->custom_flags = OPERATION_PRIORITY_DONE;
+    stack.remove_last();
+  }
+}
+
+/* Calculate priorities of all operations which are to be evaluated, to schedule the initially
+ * ready ones in the order of decreasing priority. */
+void calculate_priorities(DepsgraphEvalState *state, Depsgraph *graph)
+{
+  Vector<OperationNode *> &scheduled_operations = state->scheduled_operations;
+  for (OperationNode *node : graph->operations) {
+    node->custom_flags = OPERATION_PRIORITY_NONE;
+    node->priority = 0.0;
+    if (need_evaluate_operation(node)) {
+      scheduled_operations.append(node);
+    }
+  }
+  for (OperationNode *node : scheduled_operations) {
+    if (node->custom_flags == OPERATION_PRIORITY_NONE) {
+      calculate_priority_for_node(node, true);
+    }
+  }
+  /* Initially ready operations are picked up by the worker threads in the order they were
+   * pushed, so push them in the order of decreasing priority. */
+  std::stable_sort(scheduled_operations.begin(),
+                   scheduled_operations.end(),
+                   [](const OperationNode *a, const OperationNode *b) {
+                     return a->priority > b->priority;
+                   });
+}
+
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
-  const bool do_stats = state->do_stats;
   calculate_pending_parents(graph);
   /* Clear tags and other things which needs to be clear. */
   for (OperationNode *node : graph->operations) {
-    if (do_stats) {
-      node->stats.reset_current();
-    }
+    node->stats.reset_current();
   }
+  calculate_priorities(state, graph);
 }
 
 bool is_metaball_object_operation(const OperationNode *operation_node)
@@ -281,7 +380,7 @@ void schedule_graph(DepsgraphEvalState *state,
                     ScheduleFunction *schedule_function,
                     ScheduleFunctionArgs... schedule_function_args)
 {
-  for (OperationNode *node : state->graph->operations) {
+  for (OperationNode *node : state->scheduled_operations) {
     schedule_node(state, node, false, schedule_function, schedule_function_args...);
   }
 }
@@ -348,6 +447,35 @@ void depsgraph_ensure_view_layer(Depsgraph *graph)
 
 }  // namespace
 
+/**
+ * Order relations of all operations so that children on the critical path are scheduled last.
+ * Task scheduler runs the most recently pushed task first on the current thread, so the critical
+ * path continues without waiting for other threads.
+ *
+ * The priorities are calculated for the whole graph, so this only needs to be done once after the
+ * graph is built.
+ */
+void deg_graph_sort_relations_by_priority(Depsgraph *graph)
+{
+  for (OperationNode *node : graph->operations) {
+    node->custom_flags = OPERATION_PRIORITY_NONE;
+    node->priority = 0.0;
+  }
+  for (OperationNode *node : graph->operations) {
+    if (node->custom_flags == OPERATION_PRIORITY_NONE) {
+      calculate_priority_for_node(node, false);
+    }
+  }
+  for (OperationNode *node : graph->operations) {
+    std::stable_sort(node->outlinks.begin(),
+                     node->outlinks.end(),
+                     [](const Relation *a, const Relation *b) {
+                       return ((OperationNode *)a->to)->priority <
+                              ((OperationNode *)b->to)->priority;
+                     });
+  }
+}
+
 static TaskPool *deg_evaluate_task_pool_create(DepsgraphEvalState *state)
 {
   if (G.debug & G_DEBUG_DEPSGRAPH_NO_THREADS) {
@@ -407,6 +535,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
    * operation timing here, without aggregating anything to avoid any extra
    * synchronization. */
   if (state.do_stats) {
+    deg_eval_stats_update_average(graph);
     deg_eval_stats_aggregate(graph);
   }
   /* Clear any uncleared tags - just in case. */
@@ -39,5 +39,8 @@ struct Depsgraph;
  */
 void deg_evaluate_on_refresh(Depsgraph *graph);
 
+/* Order relations of the operations for the evaluation scheduler, once the graph is built. */
+void deg_graph_sort_relations_by_priority(Depsgraph *graph);
+
 }  // namespace deg
 }  // namespace blender
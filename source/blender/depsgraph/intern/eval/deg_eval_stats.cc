@@ -55,5 +55,27 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+void deg_eval_stats_update_average(Depsgraph *graph)
+{
+  /* Weight of the most recent evaluation in the running average. Keeps estimate
+   * stable against a single slow evaluation, but still follows changes in the
+   * scene setup within a few evaluations. */
+  const double current_weight = 0.25;
+  for (OperationNode *op_node : graph->operations) {
+    /* Operations which were not evaluated keep their previous estimate. */
+    if (!op_node->scheduled || op_node->is_noop()) {
+      continue;
+    }
+    Node::Stats &stats = op_node->stats;
+    if (stats.average_time == 0.0) {
+      stats.average_time = stats.current_time;
+    }
+    else {
+      stats.average_time = stats.average_time * (1.0 - current_weight) +
+                           stats.current_time * current_weight;
+    }
+  }
+}
+
 }  // namespace deg
 }  // namespace blender
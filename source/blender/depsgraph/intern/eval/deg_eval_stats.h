@@ -31,5 +31,10 @@ struct Depsgraph;
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Fold timing of the operations evaluated by the current graph evaluation into
+ * their running average, which is used as a cost estimate by the scheduler.
+ * Only done when timing is measured (G_DEBUG_DEPSGRAPH_TIME). */
+void deg_eval_stats_update_average(Depsgraph *graph);
+
 }  // namespace deg
 }  // namespace blender
@@ -163,6 +163,9 @@ struct Node {
     void reset_current();
     /* Time spend on this node during current graph evaluation. */
     double current_time;
+    /* Running average of the time spent on this node over previous graph
+     * evaluations. Used as an estimate of the node cost when scheduling. */
+    double average_time;
   };
   /* Relationships between nodes
    * The reason why all depsgraph nodes are descended from this type (apart
@@ -266,6 +266,11 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Estimated time needed to evaluate this operation and the most expensive
+   * chain of operations which depends on it. Operations with higher priority
+   * are on the critical path of the evaluation and are scheduled first. */
+  double priority;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -3145,6 +3145,9 @@ static int duplicate_exec(bContext *C, wmOperator *op)
   BKE_main_id_tag_all(bmain, LIB_TAG_NEW, false);
   BKE_main_id_clear_newpoins(bmain);
 
+  /* Avoid scanning all IDs of a type for each new name when duplicating many objects. */
+  BKE_main_id_name_map_create(bmain);
+
   CTX_DATA_BEGIN (C, Base *, base, selected_bases) {
     Base *basen = object_add_duplicate_internal(
         bmain, scene, view_layer, base->object, dupflag, LIB_ID_DUPLICATE_IS_SUBPROCESS);
@@ -3169,6 +3172,8 @@ static int duplicate_exec(bContext *C, wmOperator *op)
   }
   CTX_DATA_END;
 
+  BKE_main_id_name_map_free(bmain);
+
   /* Note that this will also clear newid pointers and tags. */
   copy_object_set_idnew(C);
 
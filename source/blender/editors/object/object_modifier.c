@@ -98,6 +98,30 @@
 
 static void modifier_skin_customdata_delete(struct Object *ob);
 
+/* Physics modifiers make the object a collider, an effector or an emitter for other objects,
+ * which changes relations of those objects as well. */
+static bool modifier_type_affects_other_relations(int type)
+{
+  return ELEM(type,
+              eModifierType_Collision,
+              eModifierType_Surface,
+              eModifierType_Fluid,
+              eModifierType_DynamicPaint,
+              eModifierType_ParticleSystem);
+}
+
+static void object_modifier_relations_tag_update(Main *bmain,
+                                                 Object *ob,
+                                                 bool affects_other_relations)
+{
+  if (affects_other_relations) {
+    DEG_relations_tag_update(bmain);
+  }
+  else {
+    DEG_id_relations_tag_update(bmain, &ob->id);
+  }
+}
+
 /* ------------------------------------------------------------------- */
 /** \name Public Api
  * \{ */
@@ -234,7 +258,7 @@ ModifierData *ED_object_modifier_add(
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  object_modifier_relations_tag_update(bmain, ob, modifier_type_affects_other_relations(type));
 
   return new_md;
 }
@@ -389,6 +413,7 @@ bool ED_object_modifier_remove(
     ReportList *reports, Main *bmain, Scene *scene, Object *ob, ModifierData *md)
 {
   bool sort_depsgraph = false;
+  const bool affects_other_relations = modifier_type_affects_other_relations(md->type);
 
   bool ok = object_modifier_remove(bmain, scene, ob, md, &sort_depsgraph);
 
@@ -398,7 +423,7 @@ bool ED_object_modifier_remove(
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  object_modifier_relations_tag_update(bmain, ob, affects_other_relations);
 
   return true;
 }
@@ -412,16 +437,19 @@ void ED_object_modifier_clear(Main *bmain, Scene *scene, Object *ob)
     return;
   }
 
+  bool affects_other_relations = false;
+
   while (md) {
     ModifierData *next_md = md->next;
 
+    affects_other_relations |= modifier_type_affects_other_relations(md->type);
     object_modifier_remove(bmain, scene, ob, md, &sort_depsgraph);
 
     md = next_md;
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  object_modifier_relations_tag_update(bmain, ob, affects_other_relations);
 }
 
 bool ED_object_modifier_move_up(ReportList *reports, Object *ob, ModifierData *md)
@@ -1388,6 +1416,7 @@ static int modifier_apply_exec_ex(bContext *C, wmOperator *op, int apply_as, boo
   /* Store name temporarily for report. */
   char name[MAX_NAME];
   strcpy(name, md->name);
+  const bool affects_other_relations = modifier_type_affects_other_relations(md->type);
 
   if (!ED_object_modifier_apply(
           bmain, op->reports, depsgraph, scene, ob, md, apply_as, keep_modifier)) {
@@ -1395,7 +1424,7 @@ static int modifier_apply_exec_ex(bContext *C, wmOperator *op, int apply_as, boo
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  object_modifier_relations_tag_update(bmain, ob, affects_other_relations);
   WM_event_add_notifier(C, NC_OBJECT | ND_MODIFIER, ob);
 
   if (RNA_boolean_get(op->ptr, "report")) {
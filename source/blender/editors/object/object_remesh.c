@@ -33,8 +33,10 @@
 #include "BLI_math.h"
 #include "BLI_utildefines.h"
 
+#include "DNA_key_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
+#include "DNA_modifier_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_userdef_types.h"
@@ -161,6 +163,9 @@ static int voxel_remesh_exec(bContext *C, wmOperator *op)
     BKE_mesh_calc_normals(new_mesh);
   }
 
+  /* The new topology has no meaningful order, lay it out for fast sculpting. */
+  BKE_mesh_spatial_sort(new_mesh);
+
   if (mesh->flag & ME_REMESH_REPROJECT_VOLUME || mesh->flag & ME_REMESH_REPROJECT_PAINT_MASK ||
       mesh->flag & ME_REMESH_REPROJECT_SCULPT_FACE_SETS) {
     BKE_mesh_runtime_clear_geometry(mesh);
@@ -218,6 +223,153 @@ void OBJECT_OT_voxel_remesh(wmOperatorType *ot)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Spatial Sort Operator
+ * \{ */
+
+/* Whether given modifier stores data which depends on the order of the elements of
+ * \a mesh, either as the mesh of its own object or as its bind target. */
+static bool mesh_spatial_sort_modifier_is_bound(const ModifierData *md,
+                                                const Object *ob,
+                                                const Mesh *mesh)
+{
+  const bool is_own_mesh = (ob->data == mesh);
+
+  switch ((ModifierType)md->type) {
+    case eModifierType_Hook:
+      return is_own_mesh && ((const HookModifierData *)md)->indexar != NULL;
+    case eModifierType_SurfaceDeform: {
+      const SurfaceDeformModifierData *smd = (const SurfaceDeformModifierData *)md;
+      return smd->verts != NULL &&
+             (is_own_mesh || (smd->target != NULL && smd->target->data == mesh));
+    }
+    case eModifierType_MeshDeform: {
+      const MeshDeformModifierData *mmd = (const MeshDeformModifierData *)md;
+      return mmd->bindcagecos != NULL &&
+             (is_own_mesh || (mmd->object != NULL && mmd->object->data == mesh));
+    }
+    case eModifierType_LaplacianDeform:
+      return is_own_mesh &&
+             (((const LaplacianDeformModifierData *)md)->flag & MOD_LAPLACIANDEFORM_BIND);
+    case eModifierType_CorrectiveSmooth:
+      return is_own_mesh && ((const CorrectiveSmoothModifierData *)md)->bind_coords != NULL;
+    default:
+      return false;
+  }
+}
+
+/* Get the reason why the elements of \a mesh cannot be reordered, or NULL if they can. */
+static const char *mesh_spatial_sort_disabled_reason(Main *bmain, const Mesh *mesh)
+{
+  if (mesh->key != NULL) {
+    LISTBASE_FOREACH (const KeyBlock *, kb, &mesh->key->block) {
+      if (kb->totelem != mesh->totvert) {
+        return "Cannot sort a mesh with shape keys not matching its number of vertices";
+      }
+    }
+  }
+
+  LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+    /* Particles store the indices of the faces or vertices they are emitted from. */
+    if (ob->data == mesh && !BLI_listbase_is_empty(&ob->particlesystem)) {
+      return "Cannot sort a mesh used by particle systems";
+    }
+    if (ob->parent != NULL && ob->parent->data == mesh &&
+        ELEM(ob->partype, PARVERT1, PARVERT3)) {
+      return "Cannot sort a mesh used by vertex parents";
+    }
+    LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+      if (mesh_spatial_sort_modifier_is_bound(md, ob, mesh)) {
+        return "Cannot sort a mesh used by hooks or bound deform modifiers";
+      }
+    }
+  }
+  return NULL;
+}
+
+static bool mesh_spatial_sort_poll(bContext *C)
+{
+  Object *ob = CTX_data_active_object(C);
+
+  if (ob == NULL || ob->data == NULL) {
+    return false;
+  }
+
+  if (ID_IS_LINKED(ob->data) || ID_IS_OVERRIDE_LIBRARY(ob->data)) {
+    CTX_wm_operator_poll_msg_set(C, "Cannot sort linked or override data");
+    return false;
+  }
+
+  if (BKE_object_is_in_editmode(ob)) {
+    CTX_wm_operator_poll_msg_set(C, "Cannot sort the mesh from edit mode");
+    return false;
+  }
+
+  if (ob->mode == OB_MODE_SCULPT && ob->sculpt->bm) {
+    CTX_wm_operator_poll_msg_set(C, "Cannot sort the mesh with dyntopo activated");
+    return false;
+  }
+
+  if (BKE_modifiers_uses_multires(ob)) {
+    CTX_wm_operator_poll_msg_set(
+        C, "Cannot sort the mesh with a Multires modifier in the modifier stack");
+    return false;
+  }
+
+  return ED_operator_object_active_editable_mesh(C);
+}
+
+static int mesh_spatial_sort_exec(bContext *C, wmOperator *op)
+{
+  Object *ob = CTX_data_active_object(C);
+  Mesh *mesh = ob->data;
+
+  /* Looks at all objects of the file, so it is only done here and not in the poll function. */
+  const char *reason = mesh_spatial_sort_disabled_reason(CTX_data_main(C), mesh);
+  if (reason != NULL) {
+    BKE_report(op->reports, RPT_ERROR, reason);
+    return OPERATOR_CANCELLED;
+  }
+
+  if (ob->mode == OB_MODE_SCULPT) {
+    ED_sculpt_undo_geometry_begin(ob, op->type->name);
+  }
+
+  const bool sorted = BKE_mesh_spatial_sort(mesh);
+
+  if (ob->mode == OB_MODE_SCULPT) {
+    ED_sculpt_undo_geometry_end(ob);
+  }
+
+  if (!sorted) {
+    return OPERATOR_CANCELLED;
+  }
+
+  BKE_mesh_batch_cache_dirty_tag(mesh, BKE_MESH_BATCH_DIRTY_ALL);
+  DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+  WM_event_add_notifier(C, NC_GEOM | ND_DATA, mesh);
+
+  return OPERATOR_FINISHED;
+}
+
+void OBJECT_OT_mesh_spatial_sort(wmOperatorType *ot)
+{
+  /* identifiers */
+  ot->name = "Spatially Sort Mesh";
+  ot->description =
+      "Reorder vertices, edges and faces so that elements close in space are also close in "
+      "memory, which speeds up sculpting on large meshes";
+  ot->idname = "OBJECT_OT_mesh_spatial_sort";
+
+  /* api callbacks */
+  ot->poll = mesh_spatial_sort_poll;
+  ot->exec = mesh_spatial_sort_exec;
+
+  ot->flag = OPTYPE_REGISTER | OPTYPE_UNDO;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Voxel Size Operator
  * \{ */
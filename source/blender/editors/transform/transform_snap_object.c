@@ -27,6 +27,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_armature_types.h"
@@ -125,6 +126,8 @@ struct SnapObjectContext {
     /** Map object-data to objects so objects share edit mode data. */
     GHash *data_to_object_map;
     MemArena *mem_arena;
+    /** Depsgraph the mesh BVH-trees were last built for, see #snap_objects_bvh_ensure. */
+    const Depsgraph *bvh_ensure_depsgraph;
   } cache;
 
   /* Filter data, returns true to check this value */
@@ -442,6 +445,176 @@ static void iter_snap_objects(SnapObjectContext *sctx,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Parallel BVH-Tree Building
+ *
+ * Mesh BVH-trees are stored in the #Mesh_Runtime.bvh_cache of the evaluated mesh, so they are
+ * shared by all snap contexts (and thus by consecutive transform operators) and only rebuilt
+ * when the mesh is re-evaluated. Instead of building the missing trees one by one as objects
+ * are reached by a snapping pass, build the ones this pass will need in parallel beforehand.
+ *
+ * Only meshes whose bound-box passes the same test as in #raycastMesh and #snapMesh are
+ * considered, so objects far from the cursor never get a tree.
+ *
+ * This runs for the first query of a snap context (and again when it's used with another
+ * depsgraph), walking all objects on every query would cost more than it saves while the
+ * cursor moves. Trees of objects only reached by later queries, or freed by a re-evaluation,
+ * are built by the snapping pass itself.
+ * \{ */
+
+static bool snap_bound_box_check_dist(const float min[3],
+                                      const float max[3],
+                                      const float lpmat[4][4],
+                                      const float win_size[2],
+                                      const float mval[2],
+                                      float dist_px_sq);
+
+struct SnapBVHEnsureData {
+  GSet *meshes;
+  bool use_occlusion_test;
+
+  /* Ray-cast query, when `snapdata` is NULL. */
+  const float *ray_start;
+  const float *ray_dir;
+
+  /* Snap query. */
+  const SnapData *snapdata;
+  float dist_px_sq;
+};
+
+static bool snap_bvh_bound_box_test(const struct SnapBVHEnsureData *data,
+                                    Object *ob,
+                                    const float obmat[4][4])
+{
+  BoundBox *bb = BKE_mesh_boundbox_get(ob);
+  if (bb == NULL) {
+    return true;
+  }
+
+  if (data->snapdata) {
+    const SnapData *snapdata = data->snapdata;
+    float lpmat[4][4];
+    mul_m4_m4m4(lpmat, snapdata->pmat, obmat);
+    return snap_bound_box_check_dist(
+        bb->vec[0], bb->vec[6], lpmat, snapdata->win_size, snapdata->mval, data->dist_px_sq);
+  }
+
+  float imat[4][4];
+  float ray_start_local[3], ray_normal_local[3];
+  invert_m4_m4(imat, obmat);
+  mul_v3_m4v3(ray_start_local, imat, data->ray_start);
+  mul_v3_mat3_m4v3(ray_normal_local, imat, data->ray_dir);
+  normalize_v3(ray_normal_local);
+  return isect_ray_aabb_v3_simple(
+      ray_start_local, ray_normal_local, bb->vec[0], bb->vec[6], NULL, NULL);
+}
+
+static void snap_bvh_collect_obj_fn(SnapObjectContext *sctx,
+                                    Object *ob,
+                                    float obmat[4][4],
+                                    bool UNUSED(use_obedit),
+                                    bool UNUSED(use_backface_culling),
+                                    bool is_object_active,
+                                    void *data)
+{
+  struct SnapBVHEnsureData *dt = data;
+  Mesh *me = NULL;
+
+  /* Skip the objects the snapping pass itself skips before building a tree. */
+  if (dt->snapdata == NULL && dt->use_occlusion_test && ELEM(ob->dt, OB_BOUNDBOX, OB_WIRE)) {
+    return;
+  }
+
+  switch (ob->type) {
+    case OB_MESH:
+      /* Edit-mode meshes use the edit-mesh trees, which depend on the snap callbacks. */
+      if (!BKE_object_is_in_editmode(ob) && !(dt->snapdata && ob->dt == OB_BOUNDBOX)) {
+        me = ob->data;
+      }
+      break;
+    case OB_CURVE:
+      /* Only ray-casting uses the mesh of curves, and not for the active object. */
+      if (dt->snapdata == NULL && !is_object_active) {
+        me = BKE_object_get_evaluated_mesh(ob);
+      }
+      break;
+    case OB_SURF:
+    case OB_FONT:
+      if (dt->snapdata || !is_object_active) {
+        me = BKE_object_get_evaluated_mesh(ob);
+      }
+      break;
+  }
+
+  if (me == NULL || me->totpoly == 0) {
+    return;
+  }
+
+  /* The tree of this object may already be in use by the snap context. */
+  SnapObjectData *sod = BLI_ghash_lookup(sctx->cache.object_map, ob);
+  if (sod && sod->type == SNAP_MESH && sod->treedata_mesh.tree &&
+      bvhcache_has_tree(me->runtime.bvh_cache, sod->treedata_mesh.tree)) {
+    return;
+  }
+
+  if (snap_bvh_bound_box_test(dt, ob, obmat)) {
+    BLI_gset_add(dt->meshes, me);
+  }
+}
+
+static void snap_bvh_ensure_cb(void *__restrict userdata,
+                               const int i,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  Mesh **meshes = userdata;
+  BVHTreeFromMesh treedata = {NULL};
+
+  /* The tree is stored in the mesh cache, freeing only releases the local references. */
+  BKE_bvhtree_from_mesh_get(&treedata, meshes[i], BVHTREE_FROM_LOOPTRI, 4);
+  free_bvhtree_from_mesh(&treedata);
+}
+
+/**
+ * Build the mesh BVH-trees needed by the snapping pass described by \a data,
+ * once per snap context and depsgraph.
+ * With a single mesh the tree is built by the pass itself.
+ */
+static void snap_objects_bvh_ensure(SnapObjectContext *sctx,
+                                    Depsgraph *depsgraph,
+                                    const struct SnapObjectParams *params,
+                                    struct SnapBVHEnsureData *data)
+{
+  if (sctx->cache.bvh_ensure_depsgraph == depsgraph) {
+    return;
+  }
+  sctx->cache.bvh_ensure_depsgraph = depsgraph;
+
+  data->meshes = BLI_gset_ptr_new(__func__);
+  iter_snap_objects(sctx, depsgraph, params, snap_bvh_collect_obj_fn, data);
+
+  const int meshes_len = BLI_gset_len(data->meshes);
+  if (meshes_len > 1) {
+    Mesh **meshes = MEM_malloc_arrayN(meshes_len, sizeof(*meshes), __func__);
+    int i = 0;
+    GSET_FOREACH_BEGIN (Mesh *, me, data->meshes) {
+      meshes[i++] = me;
+    }
+    GSET_FOREACH_END();
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, meshes_len, meshes, snap_bvh_ensure_cb, &settings);
+
+    MEM_freeN(meshes);
+  }
+
+  BLI_gset_free(data->meshes, NULL);
+  data->meshes = NULL;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Ray Cast Funcs
  * \{ */
@@ -1132,6 +1305,12 @@ static bool raycastObjects(SnapObjectContext *sctx,
       .ret = false,
   };
 
+  struct SnapBVHEnsureData bvh_data = {
+      .use_occlusion_test = params->use_occlusion_test,
+      .ray_start = ray_start,
+      .ray_dir = ray_dir,
+  };
+  snap_objects_bvh_ensure(sctx, depsgraph, params, &bvh_data);
   iter_snap_objects(sctx, depsgraph, params, raycast_obj_fn, &data);
 
   return data.ret;
@@ -2812,6 +2991,11 @@ static short snapObjectsRay(SnapObjectContext *sctx,
       .ret = 0,
   };
 
+  struct SnapBVHEnsureData bvh_data = {
+      .snapdata = snapdata,
+      .dist_px_sq = square_f(*dist_px),
+  };
+  snap_objects_bvh_ensure(sctx, depsgraph, params, &bvh_data);
   iter_snap_objects(sctx, depsgraph, params, snap_obj_fn, &data);
 
   return data.ret;
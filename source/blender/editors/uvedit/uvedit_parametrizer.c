@@ -28,6 +28,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "uvedit_parametrizer.h"
@@ -4591,51 +4592,87 @@ void param_construct_end(ParamHandle *handle, ParamBool fill, ParamBool impl)
   phandle->state = PHANDLE_STATE_CONSTRUCTED;
 }
 
+/* Charts don't share any data once split, so they are unwrapped in parallel.
+ * Chart sizes vary a lot, so let the scheduler balance them one by one. */
+static void p_charts_parallel_settings(PHandle *phandle, TaskParallelSettings *settings)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  settings->use_threading = (phandle->ncharts > 1);
+  settings->min_iter_per_thread = 1;
+}
+
+typedef struct PLscmBeginData {
+  PHandle *phandle;
+  PBool live;
+  PBool abf;
+} PLscmBeginData;
+
+static void p_chart_lscm_begin_task_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PLscmBeginData *data = userdata;
+  PChart *chart = data->phandle->charts[i];
+  PFace *f;
+
+  for (f = chart->faces; f; f = f->nextlink) {
+    p_face_backup_uvs(f);
+  }
+  p_chart_lscm_begin(chart, data->live, data->abf);
+}
+
 void param_lscm_begin(ParamHandle *handle, ParamBool live, ParamBool abf)
 {
   PHandle *phandle = (PHandle *)handle;
-  PFace *f;
-  int i;
 
   param_assert(phandle->state == PHANDLE_STATE_CONSTRUCTED);
   phandle->state = PHANDLE_STATE_LSCM;
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    for (f = phandle->charts[i]->faces; f; f = f->nextlink) {
-      p_face_backup_uvs(f);
+  PLscmBeginData data = {
+      .phandle = phandle,
+      .live = (PBool)live,
+      .abf = (PBool)abf,
+  };
+
+  TaskParallelSettings settings;
+  p_charts_parallel_settings(phandle, &settings);
+  BLI_task_parallel_range(0, phandle->ncharts, &data, p_chart_lscm_begin_task_cb, &settings);
+}
+
+static void p_chart_lscm_solve_task_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PHandle *phandle = userdata;
+  PChart *chart = phandle->charts[i];
+  PBool result;
+
+  if (chart->u.lscm.context) {
+    result = p_chart_lscm_solve(phandle, chart);
+
+    if (result && !(chart->flag & PCHART_HAS_PINS)) {
+      p_chart_rotate_minimum_area(chart);
+    }
+    else if (result && chart->u.lscm.single_pin) {
+      p_chart_rotate_fit_aabb(chart);
+      p_chart_lscm_transform_single_pin(chart);
+    }
+
+    if (!result || !(chart->flag & PCHART_HAS_PINS)) {
+      p_chart_lscm_end(chart);
     }
-    p_chart_lscm_begin(phandle->charts[i], (PBool)live, (PBool)abf);
   }
 }
 
 void param_lscm_solve(ParamHandle *handle)
 {
   PHandle *phandle = (PHandle *)handle;
-  PChart *chart;
-  int i;
-  PBool result;
 
   param_assert(phandle->state == PHANDLE_STATE_LSCM);
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    chart = phandle->charts[i];
-
-    if (chart->u.lscm.context) {
-      result = p_chart_lscm_solve(phandle, chart);
-
-      if (result && !(chart->flag & PCHART_HAS_PINS)) {
-        p_chart_rotate_minimum_area(chart);
-      }
-      else if (result && chart->u.lscm.single_pin) {
-        p_chart_rotate_fit_aabb(chart);
-        p_chart_lscm_transform_single_pin(chart);
-      }
-
-      if (!result || !(chart->flag & PCHART_HAS_PINS)) {
-        p_chart_lscm_end(chart);
-      }
-    }
-  }
+  TaskParallelSettings settings;
+  p_charts_parallel_settings(phandle, &settings);
+  BLI_task_parallel_range(0, phandle->ncharts, phandle, p_chart_lscm_solve_task_cb, &settings);
 }
 
 void param_lscm_end(ParamHandle *handle)
@@ -232,7 +232,8 @@ GpencilModifierTypeInfo modifierType_Gpencil_Armature = {
     /* structName */ "ArmatureGpencilModifierData",
     /* structSize */ sizeof(ArmatureGpencilModifierData),
     /* type */ eGpencilModifierTypeType_Gpencil,
-    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode,
+    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode |
+        eGpencilModifierTypeFlag_SupportsThreadedDeform,
 
     /* copyData */ copyData,
 
@@ -125,12 +125,12 @@ BLI_INLINE float table_sample(float *table, float x)
 }
 
 /* aply noise effect based on stroke direction */
-static void deformStroke(GpencilModifierData *md,
-                         Depsgraph *depsgraph,
-                         Object *ob,
-                         bGPDlayer *gpl,
-                         bGPDframe *gpf,
-                         bGPDstroke *gps)
+static void deform_stroke(GpencilModifierData *md,
+                          Depsgraph *depsgraph,
+                          Object *ob,
+                          bGPDlayer *gpl,
+                          bGPDstroke *gps,
+                          const int stroke_index)
 {
   NoiseGpencilModifierData *mmd = (NoiseGpencilModifierData *)md;
   MDeformVert *dvert = NULL;
@@ -157,9 +157,7 @@ static void deformStroke(GpencilModifierData *md,
   }
 
   int seed = mmd->seed;
-  /* FIXME(fclem): This is really slow. We should get the stroke index in another way. */
-  int stroke_seed = BLI_findindex(&gpf->strokes, gps);
-  seed += stroke_seed;
+  seed += stroke_index;
 
   /* Make sure different modifiers get different seeds. */
   seed += BLI_hash_string(ob->id.name + 2);
@@ -254,6 +252,16 @@ static void deformStroke(GpencilModifierData *md,
   MEM_SAFE_FREE(noise_table_uvs);
 }
 
+static void deformStroke(GpencilModifierData *md,
+                         Depsgraph *depsgraph,
+                         Object *ob,
+                         bGPDlayer *gpl,
+                         bGPDframe *UNUSED(gpf),
+                         bGPDstroke *gps)
+{
+  deform_stroke(md, depsgraph, ob, gpl, gps, gps->runtime.stroke_index);
+}
+
 static void bakeModifier(struct Main *UNUSED(bmain),
                          Depsgraph *depsgraph,
                          GpencilModifierData *md,
@@ -263,8 +271,9 @@ static void bakeModifier(struct Main *UNUSED(bmain),
 
   LISTBASE_FOREACH (bGPDlayer *, gpl, &gpd->layers) {
     LISTBASE_FOREACH (bGPDframe *, gpf, &gpl->frames) {
+      int stroke_index = 0;
       LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
-        deformStroke(md, depsgraph, ob, gpl, gpf, gps);
+        deform_stroke(md, depsgraph, ob, gpl, gps, stroke_index++);
       }
     }
   }
@@ -345,7 +354,8 @@ GpencilModifierTypeInfo modifierType_Gpencil_Noise = {
     /* structName */ "NoiseGpencilModifierData",
     /* structSize */ sizeof(NoiseGpencilModifierData),
     /* type */ eGpencilModifierTypeType_Gpencil,
-    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode,
+    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode |
+        eGpencilModifierTypeFlag_SupportsThreadedDeform,
 
     /* copyData */ copyData,
 
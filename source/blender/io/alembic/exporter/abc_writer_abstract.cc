@@ -75,6 +75,19 @@ void ABCAbstractWriter::write(HierarchyContext &context)
   frame_has_been_written_ = true;
 }
 
+void ABCAbstractWriter::prepare(HierarchyContext &context)
+{
+  if (frame_has_been_written_ && !is_animated_) {
+    /* Nothing will be written, see write(). */
+    return;
+  }
+  do_prepare(context);
+}
+
+void ABCAbstractWriter::do_prepare(HierarchyContext & /*context*/)
+{
+}
+
 void ABCAbstractWriter::ensure_custom_properties_exporter(const HierarchyContext &context)
 {
   if (!args_.export_params->export_custom_properties) {
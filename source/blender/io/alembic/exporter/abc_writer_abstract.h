@@ -54,6 +54,7 @@ class ABCAbstractWriter : public AbstractHierarchyWriter {
   virtual ~ABCAbstractWriter();
 
   virtual void write(HierarchyContext &context) override;
+  virtual void prepare(HierarchyContext &context) override;
 
   /* Returns true if the data to be written is actually supported. This would, for example, allow a
    * hypothetical camera writer accept a perspective camera but reject an orthogonal one.
@@ -85,6 +86,9 @@ class ABCAbstractWriter : public AbstractHierarchyWriter {
 
  protected:
   virtual void do_write(HierarchyContext &context) = 0;
+  /* Prepare the data written by do_write(), see AbstractHierarchyWriter::prepare().
+   * Does nothing by default. */
+  virtual void do_prepare(HierarchyContext &context);
 
   virtual void update_bounding_box(Object *object);
 
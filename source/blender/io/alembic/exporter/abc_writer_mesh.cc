@@ -84,7 +84,10 @@ static void get_loop_normals(struct Mesh *mesh,
                              bool has_flat_shaded_poly);
 
 ABCGenericMeshWriter::ABCGenericMeshWriter(const ABCWriterConstructorArgs &args)
-    : ABCAbstractWriter(args), is_subd_(false)
+    : ABCAbstractWriter(args),
+      is_subd_(false),
+      prepared_mesh_(nullptr),
+      prepared_mesh_needsfree_(false)
 {
 }
 
@@ -115,6 +118,9 @@ void ABCGenericMeshWriter::create_alembic_objects(const HierarchyContext *contex
 
 ABCGenericMeshWriter::~ABCGenericMeshWriter()
 {
+  if (prepared_mesh_ != nullptr && prepared_mesh_needsfree_) {
+    BKE_id_free(nullptr, prepared_mesh_);
+  }
 }
 
 Alembic::Abc::OObject ABCGenericMeshWriter::get_alembic_object() const
@@ -171,15 +177,20 @@ bool ABCGenericMeshWriter::is_supported(const HierarchyContext *context) const
   return true;
 }
 
-void ABCGenericMeshWriter::do_write(HierarchyContext &context)
+void ABCGenericMeshWriter::do_prepare(HierarchyContext &context)
 {
-  Object *object = context.object;
-  bool needsfree = false;
+  BLI_assert(prepared_mesh_ == nullptr);
+  prepared_mesh_needsfree_ = false;
+  prepared_mesh_ = get_final_export_mesh(context.object, prepared_mesh_needsfree_);
+}
 
-  Mesh *mesh = get_export_mesh(object, needsfree);
+Mesh *ABCGenericMeshWriter::get_final_export_mesh(Object *object_eval, bool &r_needsfree)
+{
+  bool needsfree = false;
+  Mesh *mesh = get_export_mesh(object_eval, needsfree);
 
   if (mesh == nullptr) {
-    return;
+    return nullptr;
   }
 
   if (args_.export_params->triangulate) {
@@ -203,6 +214,28 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
     needsfree = true;
   }
 
+  r_needsfree = needsfree;
+  return mesh;
+}
+
+void ABCGenericMeshWriter::do_write(HierarchyContext &context)
+{
+  bool needsfree = false;
+  Mesh *mesh;
+
+  if (prepared_mesh_ != nullptr) {
+    mesh = prepared_mesh_;
+    needsfree = prepared_mesh_needsfree_;
+    prepared_mesh_ = nullptr;
+  }
+  else {
+    mesh = get_final_export_mesh(context.object, needsfree);
+  }
+
+  if (mesh == nullptr) {
+    return;
+  }
+
   m_custom_data_config.pack_uvs = args_.export_params->packuv;
   m_custom_data_config.mpoly = mesh->mpoly;
   m_custom_data_config.mloop = mesh->mloop;
@@ -49,6 +49,10 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
 
   CDStreamConfig m_custom_data_config;
 
+  /* Mesh computed by do_prepare(), consumed by the following do_write(). */
+  Mesh *prepared_mesh_;
+  bool prepared_mesh_needsfree_;
+
  public:
   explicit ABCGenericMeshWriter(const ABCWriterConstructorArgs &args);
   virtual ~ABCGenericMeshWriter();
@@ -59,6 +63,7 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
 
  protected:
   virtual bool is_supported(const HierarchyContext *context) const override;
+  virtual void do_prepare(HierarchyContext &context) override;
   virtual void do_write(HierarchyContext &context) override;
 
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) = 0;
@@ -67,6 +72,9 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
   virtual bool export_as_subdivision_surface(Object *ob_eval) const;
 
  private:
+  /* Get the export mesh, triangulated when requested by the export parameters. */
+  Mesh *get_final_export_mesh(Object *object_eval, bool &r_needsfree);
+
   void write_mesh(HierarchyContext &context, Mesh *mesh);
   void write_subd(HierarchyContext &context, Mesh *mesh);
   template<typename Schema> void write_face_sets(Object *object, Mesh *mesh, Schema &schema);
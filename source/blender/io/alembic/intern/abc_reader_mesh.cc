@@ -192,20 +192,12 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
 {
   MPoly *mpolys = config.mpoly;
   MLoop *mloops = config.mloop;
-  MLoopUV *mloopuvs = config.mloopuv;
 
   const Int32ArraySamplePtr &face_indices = mesh_data.face_indices;
   const Int32ArraySamplePtr &face_counts = mesh_data.face_counts;
-  const V2fArraySamplePtr &uvs = mesh_data.uvs;
-  const size_t uvs_size = uvs == nullptr ? 0 : uvs->size();
 
-  const UInt32ArraySamplePtr &uvs_indices = mesh_data.uvs_indices;
-
-  const bool do_uvs = (mloopuvs && uvs && uvs_indices) &&
-                      (uvs_indices->size() == face_indices->size());
   unsigned int loop_index = 0;
   unsigned int rev_loop_index = 0;
-  unsigned int uv_index = 0;
   bool seen_invalid_geometry = false;
 
   for (int i = 0; i < face_counts->size(); i++) {
@@ -233,20 +225,6 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
         seen_invalid_geometry = true;
       }
       last_vertex_index = loop.v;
-
-      if (do_uvs) {
-        MLoopUV &loopuv = mloopuvs[rev_loop_index];
-
-        uv_index = (*uvs_indices)[loop_index];
-
-        /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
-        if (uv_index >= uvs_size) {
-          continue;
-        }
-
-        loopuv.uv[0] = (*uvs)[uv_index][0];
-        loopuv.uv[1] = (*uvs)[uv_index][1];
-      }
     }
   }
 
@@ -259,6 +237,51 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
   }
 }
 
+/* UVs are per loop, but do not depend on how the faces are stored in the mesh, so they are read
+ * separately from the faces and also when the faces of the existing mesh are kept. */
+static void read_uvs(CDStreamConfig &config, const AbcMeshData &mesh_data)
+{
+  MLoopUV *mloopuvs = config.mloopuv;
+
+  const Int32ArraySamplePtr &face_indices = mesh_data.face_indices;
+  const Int32ArraySamplePtr &face_counts = mesh_data.face_counts;
+  const V2fArraySamplePtr &uvs = mesh_data.uvs;
+  const size_t uvs_size = uvs == nullptr ? 0 : uvs->size();
+
+  const UInt32ArraySamplePtr &uvs_indices = mesh_data.uvs_indices;
+
+  const bool do_uvs = (mloopuvs && uvs && uvs_indices) &&
+                      (uvs_indices->size() == face_indices->size());
+  if (!do_uvs) {
+    return;
+  }
+
+  unsigned int loop_index = 0;
+  unsigned int rev_loop_index = 0;
+  unsigned int uv_index = 0;
+
+  for (int i = 0; i < face_counts->size(); i++) {
+    const int face_size = (*face_counts)[i];
+
+    /* NOTE: Alembic data is stored in the reverse order. */
+    rev_loop_index = loop_index + (face_size - 1);
+
+    for (int f = 0; f < face_size; f++, loop_index++, rev_loop_index--) {
+      MLoopUV &loopuv = mloopuvs[rev_loop_index];
+
+      uv_index = (*uvs_indices)[loop_index];
+
+      /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
+      if (uv_index >= uvs_size) {
+        continue;
+      }
+
+      loopuv.uv[0] = (*uvs)[uv_index][0];
+      loopuv.uv[1] = (*uvs)[uv_index][1];
+    }
+  }
+}
+
 static void process_no_normals(CDStreamConfig &config)
 {
   /* Absence of normals in the Alembic mesh is interpreted as 'smooth'. */
@@ -424,11 +447,10 @@ static void get_weight_and_index(CDStreamConfig &config,
 static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
+                             const IPolyMeshSchema::Sample &sample,
                              const ISampleSelector &selector,
                              CDStreamConfig &config)
 {
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
-
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
   abc_mesh_data.face_indices = sample.getFaceIndices();
@@ -455,6 +477,10 @@ static void read_mesh_sample(const std::string &iobject_full_name,
     process_normals(config, schema.getNormalsParam(), selector);
   }
 
+  if ((settings->read_flag & MOD_MESHSEQ_READ_UV) != 0) {
+    read_uvs(config, abc_mesh_data);
+  }
+
   if ((settings->read_flag & (MOD_MESHSEQ_READ_UV | MOD_MESHSEQ_READ_COLOR)) != 0) {
     read_custom_data(iobject_full_name, schema.getArbGeomParams(), config, selector);
   }
@@ -673,7 +699,18 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   ImportSettings settings;
   settings.read_flag |= read_flag;
 
-  if (topology_changed(existing_mesh, sample_sel)) {
+  const bool topology_differs = positions->size() != existing_mesh->totvert ||
+                                face_counts->size() != existing_mesh->totpoly ||
+                                face_indices->size() != existing_mesh->totloop;
+  /* When the schema guarantees the same faces for all samples, the faces of the existing mesh
+   * (created from this object on import) are kept and only the per-sample data is read: positions,
+   * normals, UVs and colors. */
+  const bool use_topology_stable_path = !topology_differs &&
+                                        (m_schema.isConstant() ||
+                                         m_schema.getTopologyVariance() ==
+                                             Alembic::AbcGeom::kHomogenousTopology);
+
+  if (topology_differs) {
     new_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions->size(), 0, 0, face_indices->size(), face_counts->size());
 
@@ -693,6 +730,9 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
             " mesh. Only vertices will be read!";
       }
     }
+    else if (use_topology_stable_path) {
+      settings.read_flag &= ~MOD_MESHSEQ_READ_POLY;
+    }
   }
 
   Mesh *mesh_to_export = new_mesh ? new_mesh : existing_mesh;
@@ -701,7 +741,12 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample, sample_sel, config);
+
+  if (use_topology_stable_path && (read_flag & MOD_MESHSEQ_READ_POLY) != 0) {
+    /* Normals are read along with the faces, but still change with the positions. */
+    process_normals(config, m_schema.getNormalsParam(), sample_sel);
+  }
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
@@ -824,6 +869,7 @@ static void read_subd_sample(const std::string &iobject_full_name,
      * mesh. Currently we don't add a subdivision modifier when we load such data. This code is
      * assuming that the subdivided surface should be smooth. */
     read_mpolys(config, abc_mesh_data);
+    read_uvs(config, abc_mesh_data);
     process_no_normals(config);
   }
 
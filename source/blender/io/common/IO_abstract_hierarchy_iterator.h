@@ -42,6 +42,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 struct Base;
 struct Depsgraph;
@@ -127,6 +128,11 @@ class AbstractHierarchyWriter {
  public:
   virtual ~AbstractHierarchyWriter();
   virtual void write(HierarchyContext &context) = 0;
+
+  /* Prepare the data for the write() call that follows, without writing anything to the export
+   * file. It is called for different writers in parallel, so it should only modify data owned by
+   * the writer. The default implementation does nothing. */
+  virtual void prepare(HierarchyContext &context);
   /* TODO(Sybren): add function like absent() that's called when a writer was previously created,
    * but wasn't used while exporting the current frame (for example, a particle-instanced mesh of
    * which the particle is no longer alive). */
@@ -172,6 +178,7 @@ class EnsuredWriter {
   /* These operators make an EnsuredWriter* act as an AbstractHierarchyWriter* */
   operator bool() const;
   AbstractHierarchyWriter *operator->();
+  AbstractHierarchyWriter *get();
 };
 
 /* Unique identifier for a (potentially duplicated) object.
@@ -229,6 +236,14 @@ class AbstractHierarchyIterator {
   WriterMap writers_;
   ExportSubset export_subset_;
 
+  /* Writes requested by make_writers() for the current iteration, in the order they were
+   * requested. Performed by write_scheduled() once all writers have been created. */
+  struct ScheduledWrite {
+    AbstractHierarchyWriter *writer;
+    HierarchyContext context;
+  };
+  std::vector<ScheduledWrite> scheduled_writes_;
+
  public:
   explicit AbstractHierarchyIterator(Depsgraph *depsgraph);
   virtual ~AbstractHierarchyIterator();
@@ -284,11 +299,16 @@ class AbstractHierarchyIterator {
   void determine_duplication_references(const HierarchyContext *parent_context,
                                         std::string indent);
 
-  /* These three functions create writers and call their write() method. */
+  /* These three functions create writers and schedule calls to their write() method. */
   void make_writers(const HierarchyContext *parent_context);
   void make_writer_object_data(const HierarchyContext *context);
   void make_writers_particle_systems(const HierarchyContext *context);
 
+  void schedule_write(EnsuredWriter &writer, const HierarchyContext &context);
+  /* Prepare the scheduled writes in parallel batches, writing each batch one by one before
+   * preparing the next. */
+  void write_scheduled();
+
   /* Return the appropriate HierarchyContext for the data of the object represented by
    * object_context. */
   HierarchyContext context_for_object_data(const HierarchyContext *object_context) const;
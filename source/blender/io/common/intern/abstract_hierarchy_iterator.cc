@@ -19,6 +19,7 @@
 #include "IO_abstract_hierarchy_iterator.h"
 #include "dupli_parent_finder.hh"
 
+#include <algorithm>
 #include <iostream>
 #include <limits.h>
 #include <sstream>
@@ -34,6 +35,8 @@
 #include "BLI_assert.h"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "DNA_ID.h"
 #include "DNA_layer_types.h"
@@ -137,10 +140,19 @@ AbstractHierarchyWriter *EnsuredWriter::operator->()
   return writer_;
 }
 
+AbstractHierarchyWriter *EnsuredWriter::get()
+{
+  return writer_;
+}
+
 AbstractHierarchyWriter::~AbstractHierarchyWriter()
 {
 }
 
+void AbstractHierarchyWriter::prepare(HierarchyContext & /*context*/)
+{
+}
+
 bool AbstractHierarchyWriter::check_is_animated(const HierarchyContext &context) const
 {
   const Object *object = context.object;
@@ -204,6 +216,7 @@ void AbstractHierarchyIterator::iterate_and_write()
   determine_export_paths(HierarchyContext::root());
   determine_duplication_references(HierarchyContext::root(), "");
   make_writers(HierarchyContext::root());
+  write_scheduled();
   export_graph_clear();
 }
 
@@ -609,7 +622,7 @@ void AbstractHierarchyIterator::make_writers(const HierarchyContext *parent_cont
       /* XXX This can lead to too many XForms being written. For example, a camera writer can
        * refuse to write an orthographic camera. By the time that this is known, the XForm has
        * already been written. */
-      transform_writer->write(*context);
+      schedule_write(transform_writer, *context);
     }
 
     if (!context->weak_export) {
@@ -625,6 +638,53 @@ void AbstractHierarchyIterator::make_writers(const HierarchyContext *parent_cont
    */
 }
 
+void AbstractHierarchyIterator::schedule_write(EnsuredWriter &writer,
+                                               const HierarchyContext &context)
+{
+  scheduled_writes_.push_back({writer.get(), context});
+}
+
+void AbstractHierarchyIterator::write_scheduled()
+{
+  /* Preparing the data (evaluating meshes, triangulation, etc.) is independent per writer and
+   * done in parallel. Writing to the file is sequential, in the order the writes were
+   * scheduled. Prepared data is kept until it is written, so the writes are done in batches of
+   * about one per thread to bound the memory used by data prepared ahead. */
+  const size_t batch_size = (size_t)BLI_system_thread_count();
+
+  struct PrepareData {
+    std::vector<ScheduledWrite> *scheduled_writes;
+    size_t batch_start;
+  } data = {&scheduled_writes_, 0};
+
+  for (size_t batch_start = 0; batch_start < scheduled_writes_.size();
+       batch_start += batch_size) {
+    const size_t batch_end = std::min(batch_start + batch_size, scheduled_writes_.size());
+    data.batch_start = batch_start;
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    settings.use_threading = batch_end - batch_start > 1;
+    BLI_task_parallel_range(
+        0,
+        (int)(batch_end - batch_start),
+        &data,
+        [](void *__restrict userdata, const int index, const TaskParallelTLS *__restrict /*tls*/) {
+          PrepareData *data = static_cast<PrepareData *>(userdata);
+          ScheduledWrite &scheduled_write = (*data->scheduled_writes)[data->batch_start + index];
+          scheduled_write.writer->prepare(scheduled_write.context);
+        },
+        &settings);
+
+    for (size_t i = batch_start; i < batch_end; i++) {
+      ScheduledWrite &scheduled_write = scheduled_writes_[i];
+      scheduled_write.writer->write(scheduled_write.context);
+    }
+  }
+  scheduled_writes_.clear();
+}
+
 HierarchyContext AbstractHierarchyIterator::context_for_object_data(
     const HierarchyContext *object_context) const
 {
@@ -659,7 +719,7 @@ void AbstractHierarchyIterator::make_writer_object_data(const HierarchyContext *
   }
 
   if (data_writer.is_newly_created() || export_subset_.shapes) {
-    data_writer->write(data_context);
+    schedule_write(data_writer, data_context);
   }
 }
 
@@ -695,7 +755,7 @@ void AbstractHierarchyIterator::make_writers_particle_systems(
 
     /* Always write upon creation, otherwise depend on which subset is active. */
     if (writer.is_newly_created() || export_subset_.shapes) {
-      writer->write(hair_context);
+      schedule_write(writer, hair_context);
     }
   }
 }
@@ -53,6 +53,11 @@ typedef struct CustomDataLayer {
   char name[64];
   /** Layer data. */
   void *data;
+  /**
+   * Runtime: user count of `data` when it is shared with layers of other #CustomData
+   * (see #CD_SHARE), NULL when the layer is the only owner of its data.
+   */
+  struct CustomDataLayerShare *share;
 } CustomDataLayer;
 
 #define MAX_CUSTOMDATA_LAYER_NAME 64
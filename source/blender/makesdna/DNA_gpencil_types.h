@@ -180,7 +180,8 @@ typedef struct bGPDstroke_Runtime {
   int stroke_start;
   /** Triangle offset in the ibo where this fill starts. */
   int fill_start;
-  int _pad[1];
+  /** Index of the stroke in its frame, set before evaluating deform modifiers. */
+  int stroke_index;
 
   /** Original stroke (used to dereference evaluated data) */
   struct bGPDstroke *gps_orig;
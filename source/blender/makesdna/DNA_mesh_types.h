@@ -124,7 +124,12 @@ typedef struct Mesh_Runtime {
    */
   char wrapper_type_finalize;
 
-  char _pad[4];
+  /**
+   * Set when the batch cache was moved here from the previous evaluated mesh, which only differs
+   * from this one by its vertex positions. Cleared once the batch cache has been tagged dirty.
+   */
+  char batch_cache_deform_only;
+  char _pad[3];
 
   /** Needed in case we need to lazily initialize the mesh. */
   CustomData_MeshMasks cd_mask_extra;
@@ -109,8 +109,8 @@ static void createFacepa(ExplodeModifierData *emd, ParticleSystemModifierData *p
   ParticleData *pa;
   KDTree_3d *tree;
   RNG *rng;
-  float center[3], co[3];
-  int *facepa = NULL, *vertpa = NULL, totvert = 0, totface = 0, totpart = 0;
+  float(*centers)[3], co[3];
+  int *facepa = NULL, *vertpa = NULL, *facepa_nearest, totvert = 0, totface = 0, totpart = 0;
   int i, p, v1, v2, v3, v4 = 0;
   const bool invert_vgroup = (emd->flag & eExplodeFlag_INVERT_VGROUP) != 0;
 
@@ -172,8 +172,12 @@ static void createFacepa(ExplodeModifierData *emd, ParticleSystemModifierData *p
   }
   BLI_kdtree_3d_balance(tree);
 
-  /* set face-particle-indexes to nearest particle to face center */
+  facepa_nearest = MEM_malloc_arrayN(totface, sizeof(int), "explode_facepa_nearest");
+
+  /* find the nearest particle to each face center */
+  centers = MEM_malloc_arrayN(totface, sizeof(float[3]), "explode_centers");
   for (i = 0, fa = mface; i < totface; i++, fa++) {
+    float *center = centers[i];
     add_v3_v3v3(center, mvert[fa->v1].co, mvert[fa->v2].co);
     add_v3_v3(center, mvert[fa->v3].co);
     if (fa->v4) {
@@ -183,8 +187,13 @@ static void createFacepa(ExplodeModifierData *emd, ParticleSystemModifierData *p
     else {
       mul_v3_fl(center, 1.0f / 3.0f);
     }
+  }
+  BLI_kdtree_3d_find_nearest_batch(tree, centers, (uint)totface, facepa_nearest, NULL);
+  MEM_freeN(centers);
 
-    p = BLI_kdtree_3d_find_nearest(tree, center, NULL);
+  /* set face-particle-indexes to nearest particle to face center */
+  for (i = 0, fa = mface; i < totface; i++, fa++) {
+    p = facepa_nearest[i];
 
     v1 = vertpa[fa->v1];
     v2 = vertpa[fa->v2];
@@ -214,6 +223,7 @@ static void createFacepa(ExplodeModifierData *emd, ParticleSystemModifierData *p
   if (vertpa) {
     MEM_freeN(vertpa);
   }
+  MEM_freeN(facepa_nearest);
   BLI_kdtree_3d_free(tree);
 
   BLI_rng_free(rng);
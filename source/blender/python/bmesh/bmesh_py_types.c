@@ -37,6 +37,8 @@
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_query.h"
 
+#include "RNA_types.h"
+
 #include "bmesh.h"
 
 #include <Python.h>
@@ -46,6 +48,8 @@
 #include "../generic/py_capi_utils.h"
 #include "../generic/python_utildefines.h"
 
+#include "../intern/bpy_rna.h"
+
 #include "bmesh_py_types.h" /* own include */
 #include "bmesh_py_types_customdata.h"
 #include "bmesh_py_types_meshdata.h"
@@ -1040,6 +1044,10 @@ static PyObject *bpy_bmesh_to_mesh(BPy_BMesh *self, PyObject *args)
     return NULL;
   }
 
+  if (pyrna_id_buffers_exported_check(&me->id, "to_mesh()") == -1) {
+    return NULL;
+  }
+
   bm = self->bm;
 
   struct Main *bmain = NULL;
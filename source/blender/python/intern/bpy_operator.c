@@ -207,6 +207,15 @@ static PyObject *pyop_call(PyObject *UNUSED(self), PyObject *args)
     return NULL;
   }
 
+  /* Operators may re-allocate or free any data, see #pyrna_prop_collection_view_getbuffer. */
+  if (pyrna_buffers_exported_any()) {
+    PyErr_Format(PyExc_BufferError,
+                 "Calling operator \"bpy.ops.%s\" error, "
+                 "can't modify blend data while buffers are exported",
+                 opname);
+    return NULL;
+  }
+
   if (context_str) {
     if (RNA_enum_value_from_id(rna_enum_operator_context_items, context_str, &context) == 0) {
       char *enum_str = BPy_enum_as_string(rna_enum_operator_context_items);
@@ -33,6 +33,7 @@
 
 #include "BLI_bitmap.h"
 #include "BLI_dynstr.h"
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math_rotation.h"
 #include "BLI_string.h"
@@ -60,6 +61,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BKE_attribute.h"
 #include "BKE_context.h"
 #include "BKE_global.h" /* evil G.* */
 #include "BKE_idprop.h"
@@ -4538,6 +4540,8 @@ static PyObject *pyrna_prop_array_getattro(BPy_PropertyRNA *self, PyObject *pyna
   return PyObject_GenericGetAttr((PyObject *)self, pyname);
 }
 
+static PyObject *pyrna_prop_collection_view_lookup(BPy_PropertyRNA *self, const char *name);
+
 static PyObject *pyrna_prop_collection_getattro(BPy_PropertyRNA *self, PyObject *pyname)
 {
   const char *name = _PyUnicode_AsString(pyname);
@@ -4566,6 +4570,9 @@ static PyObject *pyrna_prop_collection_getattro(BPy_PropertyRNA *self, PyObject
         return ret;
       }
     }
+    if ((ret = pyrna_prop_collection_view_lookup(self, name))) {
+      return ret;
+    }
   }
 
 #if 0
@@ -5409,6 +5416,365 @@ static PyObject *pyrna_prop_collection_foreach_set(BPy_PropertyRNA *self, PyObje
   return foreach_getset(self, args, 1);
 }
 
+/* --- collection buffer view: start --- */
+/* Expose the raw array of a collection item property using the buffer protocol,
+ * so the data can be accessed without copying, e.g:
+ * `numpy.asarray(mesh.vertices.co_view)`.
+ *
+ * Buffers point into the DNA array of the collection. While buffers are exported, the owning
+ * data-block is pinned: Python calls which could re-allocate or remove it raise an error.
+ * Only data-blocks in main can be exported, since the lifetime of evaluated and other
+ * data-blocks is not under control of Python. Writing to a buffer does not send updates,
+ * this is done by calling `update()` on the view afterwards. */
+
+static PyTypeObject pyrna_prop_collection_view_Type;
+
+/* Data-blocks with exported buffers, mapped to the number of exports. */
+static GHash *pyrna_view_pinned_ids = NULL;
+
+static void pyrna_view_id_pin(ID *id)
+{
+  if (pyrna_view_pinned_ids == NULL) {
+    pyrna_view_pinned_ids = BLI_ghash_ptr_new(__func__);
+  }
+  void **count_p;
+  if (!BLI_ghash_ensure_p(pyrna_view_pinned_ids, id, &count_p)) {
+    *count_p = POINTER_FROM_INT(0);
+  }
+  *count_p = POINTER_FROM_INT(POINTER_AS_INT(*count_p) + 1);
+}
+
+static void pyrna_view_id_unpin(ID *id)
+{
+  void **count_p = BLI_ghash_lookup_p(pyrna_view_pinned_ids, id);
+  BLI_assert(count_p != NULL);
+  *count_p = POINTER_FROM_INT(POINTER_AS_INT(*count_p) - 1);
+  if (POINTER_AS_INT(*count_p) == 0) {
+    BLI_ghash_remove(pyrna_view_pinned_ids, id, NULL, NULL);
+    /* There is no exit function for the module, don't keep the hash around. */
+    if (BLI_ghash_len(pyrna_view_pinned_ids) == 0) {
+      BLI_ghash_free(pyrna_view_pinned_ids, NULL, NULL);
+      pyrna_view_pinned_ids = NULL;
+    }
+  }
+}
+
+bool pyrna_buffers_exported_any(void)
+{
+  return pyrna_view_pinned_ids != NULL;
+}
+
+bool pyrna_id_buffers_exported(const ID *id)
+{
+  return pyrna_view_pinned_ids && BLI_ghash_haskey(pyrna_view_pinned_ids, id);
+}
+
+/* Raise an error when the data-block can't be modified because of exported buffers. */
+int pyrna_id_buffers_exported_check(const ID *id, const char *error_prefix)
+{
+  if (id && pyrna_id_buffers_exported(id)) {
+    PyErr_Format(PyExc_BufferError,
+                 "%s: data-block '%.200s' has buffers exported, release them first",
+                 error_prefix,
+                 id->name + 2);
+    return -1;
+  }
+  return 0;
+}
+
+static const char *pyrna_prop_collection_view_format(RawPropertyType raw_type, bool attr_signed)
+{
+  switch (raw_type) {
+    case PROP_RAW_CHAR:
+      return attr_signed ? "b" : "B";
+    case PROP_RAW_SHORT:
+      return attr_signed ? "h" : "H";
+    case PROP_RAW_INT:
+      return attr_signed ? "i" : "I";
+    case PROP_RAW_BOOLEAN:
+      return "?";
+    case PROP_RAW_FLOAT:
+      return "f";
+    case PROP_RAW_DOUBLE:
+      return "d";
+    case PROP_RAW_UNSET:
+      break;
+  }
+  return NULL;
+}
+
+/* Return a view for `attr_view` style attribute names,
+ * NULL without an exception set when the name does not refer to a view. */
+static PyObject *pyrna_prop_collection_view_lookup(BPy_PropertyRNA *self, const char *name)
+{
+  const char *suffix = "_view";
+  const size_t name_len = strlen(name);
+  const size_t suffix_len = strlen(suffix);
+  char attr[MAX_IDPROP_NAME];
+
+  if (name_len <= suffix_len || name_len - suffix_len >= sizeof(attr) ||
+      !STREQ(name + name_len - suffix_len, suffix)) {
+    return NULL;
+  }
+  BLI_strncpy(attr, name, name_len - suffix_len + 1);
+
+  StructRNA *item_type = RNA_property_pointer_type(&self->ptr, self->prop);
+  PropertyRNA *itemprop = item_type ? RNA_struct_type_find_property(item_type, attr) : NULL;
+  if (itemprop == NULL || RNA_property_raw_type(itemprop) == PROP_RAW_UNSET ||
+      (RNA_property_flag(itemprop) & PROP_DYNAMIC)) {
+    return NULL;
+  }
+
+  BPy_PropertyCollectionViewRNA *view = PyObject_New(BPy_PropertyCollectionViewRNA,
+                                                     &pyrna_prop_collection_view_Type);
+  Py_INCREF(self);
+  view->collection = self;
+  view->itemprop = itemprop;
+  view->owner_id = self->ptr.owner_id;
+  view->owner_type = 0;
+  view->owner_session_uuid = 0;
+  view->owner_in_main = false;
+  view->path = NULL;
+  view->exports = 0;
+  view->exports_writable = false;
+  memset(&view->raw, 0, sizeof(view->raw));
+  if (view->owner_id) {
+    view->owner_type = GS(view->owner_id->name);
+    view->owner_session_uuid = view->owner_id->session_uuid;
+    view->owner_in_main = !DEG_is_evaluated_id(view->owner_id) &&
+                          !(view->owner_id->tag & LIB_TAG_NO_MAIN) &&
+                          !(view->owner_id->flag & LIB_EMBEDDED_DATA);
+    view->path = RNA_path_from_ID_to_property(&self->ptr, self->prop);
+  }
+  return (PyObject *)view;
+}
+
+/* Look up the collection of the view again, the owner may have been removed or the collection
+ * may have been re-allocated since the view was created. */
+static bool pyrna_prop_collection_view_resolve(BPy_PropertyCollectionViewRNA *self,
+                                               PointerRNA *r_ptr,
+                                               PropertyRNA **r_prop)
+{
+  BLI_assert(self->owner_in_main);
+
+  bool found = false;
+  LISTBASE_FOREACH (ID *, id, which_libbase(G_MAIN, self->owner_type)) {
+    if (id == self->owner_id) {
+      found = (id->session_uuid == self->owner_session_uuid);
+      break;
+    }
+  }
+  if (!found) {
+    return false;
+  }
+
+  if (self->path == NULL) {
+    *r_ptr = self->collection->ptr;
+    *r_prop = self->collection->prop;
+    return true;
+  }
+
+  PointerRNA id_ptr;
+  RNA_id_pointer_create(self->owner_id, &id_ptr);
+  return RNA_path_resolve_property(&id_ptr, self->path, r_ptr, r_prop) &&
+         RNA_property_type(*r_prop) == PROP_COLLECTION;
+}
+
+/* Resolve the collection, raising an error when it can't be accessed through the view. */
+static int pyrna_prop_collection_view_resolve_check(BPy_PropertyCollectionViewRNA *self,
+                                                    PointerRNA *r_ptr,
+                                                    PropertyRNA **r_prop)
+{
+  PYRNA_PROP_CHECK_INT(self->collection);
+
+  if (!self->owner_in_main) {
+    PyErr_Format(PyExc_BufferError,
+                 "bpy_prop_collection: '%.200s' is not owned by a data-block in bpy.data",
+                 RNA_property_identifier(self->itemprop));
+    return -1;
+  }
+  if (!pyrna_prop_collection_view_resolve(self, r_ptr, r_prop)) {
+    PyErr_Format(PyExc_ReferenceError,
+                 "bpy_prop_collection: the collection of '%.200s' has been removed",
+                 RNA_property_identifier(self->itemprop));
+    return -1;
+  }
+  return 0;
+}
+
+static int pyrna_prop_collection_view_getbuffer(BPy_PropertyCollectionViewRNA *self,
+                                                Py_buffer *view,
+                                                int flags)
+{
+  PropertyRNA *itemprop = self->itemprop;
+  const bool writable = (flags & PyBUF_WRITABLE) != 0;
+  PointerRNA ptr;
+  PropertyRNA *prop;
+  RawArray raw;
+
+  if (pyrna_prop_collection_view_resolve_check(self, &ptr, &prop) == -1) {
+    return -1;
+  }
+  if (!RNA_property_collection_raw_array(&ptr, prop, itemprop, &raw)) {
+    PyErr_Format(PyExc_BufferError,
+                 "bpy_prop_collection: '%.200s' can not be accessed as a buffer",
+                 RNA_property_identifier(itemprop));
+    return -1;
+  }
+
+  if (self->exports != 0) {
+    if (raw.array != self->raw.array || raw.len != self->raw.len) {
+      PyErr_Format(PyExc_BufferError,
+                   "bpy_prop_collection: '%.200s' was re-allocated while still exported, "
+                   "release existing buffers first",
+                   RNA_property_identifier(itemprop));
+      return -1;
+    }
+    /* Making the array mutable may re-allocate it, which can't be done under existing
+     * read-only exports. */
+    if (writable && !self->exports_writable) {
+      PyErr_Format(PyExc_BufferError,
+                   "bpy_prop_collection: '%.200s' is exported read-only, "
+                   "release existing buffers first",
+                   RNA_property_identifier(itemprop));
+      return -1;
+    }
+  }
+  else {
+    /* The array may be shared with the evaluated copy of the owner, writing to it would change
+     * the evaluated data as well. */
+    if (writable && raw.len != 0 &&
+        BKE_id_attribute_data_ensure_mutable(ptr.owner_id, raw.array)) {
+      RNA_property_collection_raw_array(&ptr, prop, itemprop, &raw);
+    }
+    self->exports_writable = writable;
+  }
+
+  /* Array length of the item property, it is static so the item data is not accessed. */
+  PointerRNA item_ptr;
+  RNA_pointer_create(ptr.owner_id, RNA_property_pointer_type(&ptr, prop), NULL, &item_ptr);
+  const int attr_tot = RNA_property_array_length(&item_ptr, itemprop);
+  if (raw.len == 0) {
+    /* The raw array of an empty collection has no type, export it as an empty array. */
+    raw.array = NULL;
+    raw.type = RNA_property_raw_type(itemprop);
+    raw.stride = MAX2(attr_tot, 1) * RNA_raw_type_sizeof(raw.type);
+  }
+  const int value_size = RNA_raw_type_sizeof(raw.type);
+
+  /* Items are interleaved with other members of the DNA struct, only strided requests can be
+   * served unless the property covers the whole item. */
+  if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES && raw.stride != MAX2(attr_tot, 1) * value_size) {
+    PyErr_SetString(PyExc_BufferError, "bpy_prop_collection: buffer is not contiguous");
+    return -1;
+  }
+
+  self->raw = raw;
+  self->shape[0] = raw.len;
+  self->shape[1] = attr_tot;
+  self->strides[0] = raw.stride;
+  self->strides[1] = value_size;
+
+  view->obj = (PyObject *)self;
+  view->buf = raw.array;
+  view->len = (Py_ssize_t)raw.len * MAX2(attr_tot, 1) * value_size;
+  view->readonly = !self->exports_writable;
+  view->itemsize = value_size;
+  view->format = NULL;
+  if (flags & PyBUF_FORMAT) {
+    view->format = (char *)pyrna_prop_collection_view_format(
+        raw.type, RNA_property_subtype(itemprop) != PROP_UNSIGNED);
+  }
+  view->ndim = (attr_tot > 0) ? 2 : 1;
+  view->shape = ((flags & PyBUF_ND) == PyBUF_ND) ? self->shape : NULL;
+  view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? self->strides : NULL;
+  view->suboffsets = NULL;
+  view->internal = NULL;
+
+  Py_INCREF(self);
+  if (self->exports++ == 0) {
+    pyrna_view_id_pin(self->owner_id);
+  }
+  return 0;
+}
+
+static void pyrna_prop_collection_view_releasebuffer(BPy_PropertyCollectionViewRNA *self,
+                                                     Py_buffer *UNUSED(view))
+{
+  if (--self->exports == 0) {
+    pyrna_view_id_unpin(self->owner_id);
+  }
+}
+
+PyDoc_STRVAR(pyrna_prop_collection_view_update_doc,
+             ".. method:: update()\n"
+             "\n"
+             "   Send the updates of the property, to be called after writing to buffers of "
+             "the view.\n");
+static PyObject *pyrna_prop_collection_view_update(BPy_PropertyCollectionViewRNA *self)
+{
+  PointerRNA ptr;
+  PropertyRNA *prop;
+  PointerRNA item_ptr;
+
+  if (pyrna_prop_collection_view_resolve_check(self, &ptr, &prop) == -1) {
+    return NULL;
+  }
+
+  /* Update callbacks of item properties tag the data-block owning the items, so calling it
+   * for the first item covers the whole collection. An empty collection has nothing to update. */
+  if (RNA_property_collection_length(&ptr, prop) != 0 &&
+      RNA_property_collection_lookup_int(&ptr, prop, 0, &item_ptr)) {
+    RNA_property_update(BPY_context_get(), &item_ptr, self->itemprop);
+  }
+  Py_RETURN_NONE;
+}
+
+static struct PyMethodDef pyrna_prop_collection_view_methods[] = {
+    {"update",
+     (PyCFunction)pyrna_prop_collection_view_update,
+     METH_NOARGS,
+     pyrna_prop_collection_view_update_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+static void pyrna_prop_collection_view_dealloc(BPy_PropertyCollectionViewRNA *self)
+{
+  BLI_assert(self->exports == 0);
+  MEM_SAFE_FREE(self->path);
+  Py_DECREF(self->collection);
+  PyObject_DEL(self);
+}
+
+static PyObject *pyrna_prop_collection_view_repr(BPy_PropertyCollectionViewRNA *self)
+{
+  BPy_PropertyRNA *collection = self->collection;
+  PYRNA_PROP_CHECK_OBJ(collection);
+  return PyUnicode_FromFormat("<bpy_prop_collection_view, %.200s.%.200s[...].%.200s>",
+                              RNA_struct_identifier(collection->ptr.type),
+                              RNA_property_identifier(collection->prop),
+                              RNA_property_identifier(self->itemprop));
+}
+
+static PyBufferProcs pyrna_prop_collection_view_as_buffer = {
+    (getbufferproc)pyrna_prop_collection_view_getbuffer,
+    (releasebufferproc)pyrna_prop_collection_view_releasebuffer,
+};
+
+static void pyrna_prop_collection_view_type_init(void)
+{
+  PyTypeObject *type = &pyrna_prop_collection_view_Type;
+  type->tp_name = "bpy_prop_collection_view";
+  type->tp_basicsize = sizeof(BPy_PropertyCollectionViewRNA);
+  type->tp_dealloc = (destructor)pyrna_prop_collection_view_dealloc;
+  type->tp_repr = (reprfunc)pyrna_prop_collection_view_repr;
+  type->tp_as_buffer = &pyrna_prop_collection_view_as_buffer;
+  type->tp_methods = pyrna_prop_collection_view_methods;
+  type->tp_flags = Py_TPFLAGS_DEFAULT;
+}
+
+/* --- collection buffer view: end --- */
+
 static PyObject *pyprop_array_foreach_getset(BPy_PropertyArrayRNA *self,
                                              PyObject *args,
                                              const bool do_set)
@@ -6034,6 +6400,36 @@ static PyObject *small_dict_get_item_string(PyObject *dict, const char *key_look
   return NULL;
 }
 
+static int pyrna_func_args_buffers_exported_check(BPy_FunctionRNA *self,
+                                                  PyObject *args,
+                                                  PyObject *kw)
+{
+  const char *error_prefix = RNA_function_identifier(self->func);
+  if (pyrna_id_buffers_exported_check(self->ptr.owner_id, error_prefix) == -1) {
+    return -1;
+  }
+  for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(args); i++) {
+    PyObject *item = PyTuple_GET_ITEM(args, i);
+    if (BPy_StructRNA_Check(item) &&
+        pyrna_id_buffers_exported_check(((BPy_StructRNA *)item)->ptr.owner_id, error_prefix) ==
+            -1) {
+      return -1;
+    }
+  }
+  if (kw) {
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(kw, &pos, &key, &value)) {
+      if (BPy_StructRNA_Check(value) &&
+          pyrna_id_buffers_exported_check(((BPy_StructRNA *)value)->ptr.owner_id,
+                                          error_prefix) == -1) {
+        return -1;
+      }
+    }
+  }
+  return 0;
+}
+
 static PyObject *pyrna_func_call(BPy_FunctionRNA *self, PyObject *args, PyObject *kw)
 {
   /* Note, both BPy_StructRNA and BPy_PropertyRNA can be used here. */
@@ -6076,6 +6472,12 @@ static PyObject *pyrna_func_call(BPy_FunctionRNA *self, PyObject *args, PyObject
     return NULL;
   }
 
+  /* Functions may re-allocate or free the data-blocks they operate on,
+   * which can't be done while buffers to their data are exported. */
+  if (pyrna_buffers_exported_any() && pyrna_func_args_buffers_exported_check(self, args, kw)) {
+    return NULL;
+  }
+
   /* For testing. */
 #if 0
   {
@@ -7605,6 +8007,11 @@ void BPY_rna_init(void)
     return;
   }
 #endif
+
+  pyrna_prop_collection_view_type_init();
+  if (PyType_Ready(&pyrna_prop_collection_view_Type) < 0) {
+    return;
+  }
 }
 
 /* 'bpy.data' from Python. */
@@ -168,6 +168,34 @@ typedef struct {
   CollectionPropertyIterator iter;
 } BPy_PropertyCollectionIterRNA;
 
+/* Buffer view of a single item property over all items of a collection,
+ * e.g: `mesh.vertices.co_view`. */
+typedef struct {
+  PyObject_HEAD /* required python macro   */
+  /** The collection, keeps the python wrapper of its owner alive while the view exists. */
+  BPy_PropertyRNA *collection;
+  /** Property of the collection items exposed by the view. */
+  PropertyRNA *itemprop;
+  /**
+   * Owner of the collection and the path to it from the owner. The collection is looked up
+   * again for every access, the owner may be removed while the view exists.
+   * Only owners in main can be exported, see `owner_in_main`.
+   */
+  struct ID *owner_id;
+  short owner_type;
+  unsigned int owner_session_uuid;
+  bool owner_in_main;
+  char *path;
+  /** Number of exported buffers, the owner is pinned while non-zero. */
+  int exports;
+  /** Exported buffers are writable, only valid while exported. */
+  bool exports_writable;
+  /** Array of the exported buffers, only valid while exported. */
+  RawArray raw;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+} BPy_PropertyCollectionViewRNA;
+
 typedef struct {
   PyObject_HEAD /* required python macro   */
 #ifdef USE_WEAKREFS
@@ -252,6 +280,10 @@ PyObject *pyrna_math_object_from_array(PointerRNA *ptr, PropertyRNA *prop);
 int pyrna_array_contains_py(PointerRNA *ptr, PropertyRNA *prop, PyObject *value);
 
 bool pyrna_write_check(void);
+
+bool pyrna_buffers_exported_any(void);
+bool pyrna_id_buffers_exported(const struct ID *id);
+int pyrna_id_buffers_exported_check(const struct ID *id, const char *error_prefix);
 void pyrna_write_set(bool val);
 
 void pyrna_invalidate(BPy_DummyPointerRNA *self);
@@ -328,6 +328,10 @@ static PyObject *bpy_batch_remove(PyObject *UNUSED(self), PyObject *args, PyObje
         Py_DECREF(ids_fast);
         goto error;
       }
+      if (pyrna_id_buffers_exported_check(id, "batch_remove") == -1) {
+        Py_DECREF(ids_fast);
+        goto error;
+      }
 
       id->tag |= LIB_TAG_DOIT;
     }
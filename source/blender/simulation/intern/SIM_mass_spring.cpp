@@ -32,6 +32,7 @@
 
 #include "BLI_linklist.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_cloth.h"
@@ -366,7 +367,41 @@ static int UNUSED_FUNCTION(cloth_calc_helper_forces)(Object *UNUSED(ob),
   return 1;
 }
 
-BLI_INLINE void cloth_calc_spring_force(ClothModifierData *clmd, ClothSpring *s)
+/* How the evaluated force of a spring is added to the solver data. */
+enum {
+  CLOTH_SPRING_FORCE_NONE = 0,
+  CLOTH_SPRING_FORCE_LINEAR,
+  CLOTH_SPRING_FORCE_ANGULAR,
+  /* Hair bending springs are evaluated while applying. */
+  CLOTH_SPRING_FORCE_HAIR_BENDING,
+};
+
+typedef struct ClothSpringForce {
+  int type;
+  ImplicitSpringForce force;
+} ClothSpringForce;
+
+BLI_INLINE void cloth_hair_bending_stiffness(const ClothSimSettings *parms,
+                                             const ClothSpring *s,
+                                             float *r_kb,
+                                             float *r_cb)
+{
+  /* XXX WARNING: angular bending springs for hair apply stiffness factor as an overall factor,
+   * unlike cloth springs! this is crap, but needed due to cloth/hair mixing ... max_bend factor
+   * is not even used for hair, so ...
+   */
+  float scaling = s->lin_stiffness * parms->bending;
+  *r_kb = scaling / (20.0f * (parms->avg_spring_len + FLT_EPSILON));
+
+  /* Fix for T45084 for cloth stiffness must have cb proportional to kb */
+  *r_cb = *r_kb * parms->bending_damping;
+}
+
+/* Evaluate the force of a spring, only reads the solver data so springs can be evaluated in
+ * parallel. The result is added to the solver data by #cloth_apply_spring_force. */
+BLI_INLINE void cloth_calc_spring_force(ClothModifierData *clmd,
+                                        ClothSpring *s,
+                                        ClothSpringForce *r_force)
 {
   Cloth *cloth = clmd->clothObject;
   ClothSimSettings *parms = clmd->sim_parms;
@@ -376,6 +411,7 @@ BLI_INLINE void cloth_calc_spring_force(ClothModifierData *clmd, ClothSpring *s)
                          !using_angular;
 
   s->flags &= ~CLOTH_SPRING_FLAG_NEEDED;
+  r_force->type = CLOTH_SPRING_FORCE_NONE;
 
   /* Calculate force of bending springs. */
   if ((s->type & CLOTH_SPRING_TYPE_BENDING) && using_angular) {
@@ -388,8 +424,19 @@ BLI_INLINE void cloth_calc_spring_force(ClothModifierData *clmd, ClothSpring *s)
     k = scaling * s->restlen *
         0.1f; /* Multiplying by 0.1, just to scale the forces to more reasonable values. */
 
-    SIM_mass_spring_force_spring_angular(
-        data, s->ij, s->kl, s->pa, s->pb, s->la, s->lb, s->restang, k, parms->bending_damping);
+    if (SIM_mass_spring_eval_spring_angular(data,
+                                            s->ij,
+                                            s->kl,
+                                            s->pa,
+                                            s->pb,
+                                            s->la,
+                                            s->lb,
+                                            s->restang,
+                                            k,
+                                            parms->bending_damping,
+                                            &r_force->force)) {
+      r_force->type = CLOTH_SPRING_FORCE_ANGULAR;
+    }
 #endif
   }
 
@@ -409,17 +456,20 @@ BLI_INLINE void cloth_calc_spring_force(ClothModifierData *clmd, ClothSpring *s)
       /* TODO: verify, half verified (couldn't see error)
        * sewing springs usually have a large distance at first so clamp the force so we don't get
        * tunneling through collision objects. */
-      SIM_mass_spring_force_spring_linear(data,
-                                          s->ij,
-                                          s->kl,
-                                          s->restlen,
-                                          k_tension,
-                                          parms->tension_damp,
-                                          0.0f,
-                                          0.0f,
-                                          false,
-                                          false,
-                                          parms->max_sewing);
+      if (SIM_mass_spring_eval_spring_linear(data,
+                                             s->ij,
+                                             s->kl,
+                                             s->restlen,
+                                             k_tension,
+                                             parms->tension_damp,
+                                             0.0f,
+                                             0.0f,
+                                             false,
+                                             false,
+                                             parms->max_sewing,
+                                             &r_force->force)) {
+        r_force->type = CLOTH_SPRING_FORCE_LINEAR;
+      }
     }
     else if (s->type & CLOTH_SPRING_TYPE_STRUCTURAL) {
       float k_compression, scaling_compression;
@@ -427,17 +477,20 @@ BLI_INLINE void cloth_calc_spring_force(ClothModifierData *clmd, ClothSpring *s)
                             s->lin_stiffness * fabsf(parms->max_compression - parms->compression);
       k_compression = scaling_compression / (parms->avg_spring_len + FLT_EPSILON);
 
-      SIM_mass_spring_force_spring_linear(data,
-                                          s->ij,
-                                          s->kl,
-                                          s->restlen,
-                                          k_tension,
-                                          parms->tension_damp,
-                                          k_compression,
-                                          parms->compression_damp,
-                                          resist_compress,
-                                          using_angular,
-                                          0.0f);
+      if (SIM_mass_spring_eval_spring_linear(data,
+                                             s->ij,
+                                             s->kl,
+                                             s->restlen,
+                                             k_tension,
+                                             parms->tension_damp,
+                                             k_compression,
+                                             parms->compression_damp,
+                                             resist_compress,
+                                             using_angular,
+                                             0.0f,
+                                             &r_force->force)) {
+        r_force->type = CLOTH_SPRING_FORCE_LINEAR;
+      }
     }
     else {
       /* CLOTH_SPRING_TYPE_INTERNAL */
@@ -465,17 +518,20 @@ BLI_INLINE void cloth_calc_spring_force(ClothModifierData *clmd, ClothSpring *s)
         k_compression_damp = 0.0f;
       }
 
-      SIM_mass_spring_force_spring_linear(data,
-                                          s->ij,
-                                          s->kl,
-                                          s->restlen,
-                                          k_tension,
-                                          k_tension_damp,
-                                          k_compression,
-                                          k_compression_damp,
-                                          resist_compress,
-                                          using_angular,
-                                          0.0f);
+      if (SIM_mass_spring_eval_spring_linear(data,
+                                             s->ij,
+                                             s->kl,
+                                             s->restlen,
+                                             k_tension,
+                                             k_tension_damp,
+                                             k_compression,
+                                             k_compression_damp,
+                                             resist_compress,
+                                             using_angular,
+                                             0.0f,
+                                             &r_force->force)) {
+        r_force->type = CLOTH_SPRING_FORCE_LINEAR;
+      }
     }
 #endif
   }
@@ -488,17 +544,20 @@ BLI_INLINE void cloth_calc_spring_force(ClothModifierData *clmd, ClothSpring *s)
     scaling = parms->shear + s->lin_stiffness * fabsf(parms->max_shear - parms->shear);
     k = scaling / (parms->avg_spring_len + FLT_EPSILON);
 
-    SIM_mass_spring_force_spring_linear(data,
-                                        s->ij,
-                                        s->kl,
-                                        s->restlen,
-                                        k,
-                                        parms->shear_damp,
-                                        0.0f,
-                                        0.0f,
-                                        resist_compress,
-                                        false,
-                                        0.0f);
+    if (SIM_mass_spring_eval_spring_linear(data,
+                                           s->ij,
+                                           s->kl,
+                                           s->restlen,
+                                           k,
+                                           parms->shear_damp,
+                                           0.0f,
+                                           0.0f,
+                                           resist_compress,
+                                           false,
+                                           0.0f,
+                                           &r_force->force)) {
+      r_force->type = CLOTH_SPRING_FORCE_LINEAR;
+    }
 #endif
   }
   else if (s->type & CLOTH_SPRING_TYPE_BENDING) { /* calculate force of bending springs */
@@ -513,52 +572,123 @@ BLI_INLINE void cloth_calc_spring_force(ClothModifierData *clmd, ClothSpring *s)
     /* Fix for T45084 for cloth stiffness must have cb proportional to kb */
     cb = kb * parms->bending_damping;
 
-    SIM_mass_spring_force_spring_bending(data, s->ij, s->kl, s->restlen, kb, cb);
+    if (SIM_mass_spring_eval_spring_bending(
+            data, s->ij, s->kl, s->restlen, kb, cb, &r_force->force)) {
+      r_force->type = CLOTH_SPRING_FORCE_LINEAR;
+    }
 #endif
   }
   else if (s->type & CLOTH_SPRING_TYPE_BENDING_HAIR) {
 #ifdef CLOTH_FORCE_SPRING_BEND
-    float kb, cb, scaling;
-
     s->flags |= CLOTH_SPRING_FLAG_NEEDED;
 
-    /* XXX WARNING: angular bending springs for hair apply stiffness factor as an overall factor,
-     * unlike cloth springs! this is crap, but needed due to cloth/hair mixing ... max_bend factor
-     * is not even used for hair, so ...
-     */
-    scaling = s->lin_stiffness * parms->bending;
-    kb = scaling / (20.0f * (parms->avg_spring_len + FLT_EPSILON));
+    r_force->type = CLOTH_SPRING_FORCE_HAIR_BENDING;
+#endif
+  }
+}
 
-    /* Fix for T45084 for cloth stiffness must have cb proportional to kb */
-    cb = kb * parms->bending_damping;
+/* Add the evaluated force of a spring to the solver data, must be called in spring order. */
+BLI_INLINE void cloth_apply_spring_force(ClothModifierData *clmd,
+                                         ClothSpring *s,
+                                         const ClothSpringForce *force)
+{
+  Cloth *cloth = clmd->clothObject;
+  Implicit_Data *data = cloth->implicit;
 
-    /* XXX assuming same restlen for ij and jk segments here,
-     * this can be done correctly for hair later. */
-    SIM_mass_spring_force_spring_bending_hair(data, s->ij, s->kl, s->mn, s->target, kb, cb);
+  switch (force->type) {
+    case CLOTH_SPRING_FORCE_LINEAR:
+      SIM_mass_spring_apply_spring_force(data, s->ij, s->kl, &force->force);
+      break;
+    case CLOTH_SPRING_FORCE_ANGULAR:
+      SIM_mass_spring_apply_spring_angular_force(
+          data, s->ij, s->kl, s->pa, s->pb, s->la, s->lb, &force->force);
+      break;
+    case CLOTH_SPRING_FORCE_HAIR_BENDING: {
+      float kb, cb;
+      cloth_hair_bending_stiffness(clmd->sim_parms, s, &kb, &cb);
+
+      /* XXX assuming same restlen for ij and jk segments here,
+       * this can be done correctly for hair later. */
+      SIM_mass_spring_force_spring_bending_hair(data, s->ij, s->kl, s->mn, s->target, kb, cb);
 
-#  if 0
-    {
-      float x_kl[3], x_mn[3], v[3], d[3];
+#if 0
+      {
+        float x_kl[3], x_mn[3], v[3], d[3];
 
-      SIM_mass_spring_get_motion_state(data, s->kl, x_kl, v);
-      SIM_mass_spring_get_motion_state(data, s->mn, x_mn, v);
+        SIM_mass_spring_get_motion_state(data, s->kl, x_kl, v);
+        SIM_mass_spring_get_motion_state(data, s->mn, x_mn, v);
 
-      BKE_sim_debug_data_add_dot(clmd->debug_data, x_kl, 0.9, 0.9, 0.9, "target", 7980, s->kl);
-      BKE_sim_debug_data_add_line(
-          clmd->debug_data, x_kl, x_mn, 0.8, 0.8, 0.8, "target", 7981, s->kl);
+        BKE_sim_debug_data_add_dot(clmd->debug_data, x_kl, 0.9, 0.9, 0.9, "target", 7980, s->kl);
+        BKE_sim_debug_data_add_line(
+            clmd->debug_data, x_kl, x_mn, 0.8, 0.8, 0.8, "target", 7981, s->kl);
 
-      copy_v3_v3(d, s->target);
-      BKE_sim_debug_data_add_vector(
-          clmd->debug_data, x_kl, d, 0.8, 0.8, 0.2, "target", 7982, s->kl);
+        copy_v3_v3(d, s->target);
+        BKE_sim_debug_data_add_vector(
+            clmd->debug_data, x_kl, d, 0.8, 0.8, 0.2, "target", 7982, s->kl);
 
-      // copy_v3_v3(d, s->target_ij);
-      // BKE_sim_debug_data_add_vector(clmd->debug_data, x, d, 1, 0.4, 0.4, "target", 7983, s->kl);
-    }
-#  endif
+        // copy_v3_v3(d, s->target_ij);
+        // BKE_sim_debug_data_add_vector(clmd->debug_data, x, d, 1, 0.4, 0.4, "target", 7983,
+        // s->kl);
+      }
 #endif
+      break;
+    }
   }
 }
 
+typedef struct ClothSpringForceData {
+  ClothModifierData *clmd;
+  ClothSpring **springs;
+  ClothSpringForce *forces;
+} ClothSpringForceData;
+
+static void cloth_calc_spring_force_task_cb(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ClothSpringForceData *data = (ClothSpringForceData *)userdata;
+
+  cloth_calc_spring_force(data->clmd, data->springs[i], &data->forces[i]);
+}
+
+/* Spring forces are evaluated in parallel, then accumulated into the shared force vector and
+ * jacobian blocks in the original spring order, so the result does not depend on threading. */
+static void cloth_calc_spring_forces(ClothModifierData *clmd)
+{
+  Cloth *cloth = clmd->clothObject;
+  int springs_num = 0;
+
+  ClothSpring **springs = (ClothSpring **)MEM_malloc_arrayN(
+      BLI_linklist_count(cloth->springs), sizeof(*springs), __func__);
+  for (LinkNode *link = cloth->springs; link; link = link->next) {
+    ClothSpring *spring = (ClothSpring *)link->link;
+    /* only handle active springs */
+    if (!(spring->flags & CLOTH_SPRING_FLAG_DEACTIVATE)) {
+      springs[springs_num++] = spring;
+    }
+  }
+
+  ClothSpringForce *forces = (ClothSpringForce *)MEM_malloc_arrayN(
+      springs_num, sizeof(*forces), __func__);
+
+  ClothSpringForceData data;
+  data.clmd = clmd;
+  data.springs = springs;
+  data.forces = forces;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, springs_num, &data, cloth_calc_spring_force_task_cb, &settings);
+
+  for (int i = 0; i < springs_num; i++) {
+    cloth_apply_spring_force(clmd, springs[i], &forces[i]);
+  }
+
+  MEM_freeN(springs);
+  MEM_freeN(forces);
+}
+
 static void hair_get_boundbox(ClothModifierData *clmd, float gmin[3], float gmax[3])
 {
   Cloth *cloth = clmd->clothObject;
@@ -789,13 +919,7 @@ static void cloth_calc_force(
   }
 
   /* calculate spring forces */
-  for (LinkNode *link = cloth->springs; link; link = link->next) {
-    ClothSpring *spring = (ClothSpring *)link->link;
-    /* only handle active springs */
-    if (!(spring->flags & CLOTH_SPRING_FLAG_DEACTIVATE)) {
-      cloth_calc_spring_force(clmd, spring);
-    }
-  }
+  cloth_calc_spring_forces(clmd);
 }
 
 /* returns vertexes' motion state */
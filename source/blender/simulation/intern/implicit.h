@@ -177,6 +177,63 @@ bool SIM_mass_spring_force_spring_bending_hair(struct Implicit_Data *data,
                                                const float target[3],
                                                float stiffness,
                                                float damping);
+/* Force and jacobians of a single spring, evaluated without modifying the solver data.
+ * Evaluating only reads the motion state, so springs can be evaluated in parallel
+ * and applied afterwards in a fixed order, which keeps the result deterministic. */
+typedef struct ImplicitSpringForce {
+  /* Force acting on the second vertex, the first vertex gets the opposite force.
+   * For angular springs: force subtracted from both edge vertices. */
+  float f[3];
+  float dfdx[3][3], dfdv[3][3];
+  /* Angular springs: force added to each vertex of the two adjacent polygons. */
+  float f_a[3], f_b[3];
+} ImplicitSpringForce;
+
+bool SIM_mass_spring_eval_spring_linear(const struct Implicit_Data *data,
+                                        int i,
+                                        int j,
+                                        float restlen,
+                                        float stiffness_tension,
+                                        float damping_tension,
+                                        float stiffness_compression,
+                                        float damping_compression,
+                                        bool resist_compress,
+                                        bool new_compress,
+                                        float clamp_force,
+                                        ImplicitSpringForce *r_force);
+bool SIM_mass_spring_eval_spring_angular(const struct Implicit_Data *data,
+                                         int i,
+                                         int j,
+                                         int *i_a,
+                                         int *i_b,
+                                         int len_a,
+                                         int len_b,
+                                         float restang,
+                                         float stiffness,
+                                         float damping,
+                                         ImplicitSpringForce *r_force);
+bool SIM_mass_spring_eval_spring_bending(const struct Implicit_Data *data,
+                                         int i,
+                                         int j,
+                                         float restlen,
+                                         float kb,
+                                         float cb,
+                                         ImplicitSpringForce *r_force);
+/* Add an evaluated linear or bending spring force to the solver data. */
+void SIM_mass_spring_apply_spring_force(struct Implicit_Data *data,
+                                        int i,
+                                        int j,
+                                        const ImplicitSpringForce *force);
+/* Add an evaluated angular spring force to the solver data. */
+void SIM_mass_spring_apply_spring_angular_force(struct Implicit_Data *data,
+                                                int i,
+                                                int j,
+                                                const int *i_a,
+                                                const int *i_b,
+                                                int len_a,
+                                                int len_b,
+                                                const ImplicitSpringForce *force);
+
 /* Global goal spring */
 bool SIM_mass_spring_force_spring_goal(struct Implicit_Data *data,
                                        int i,
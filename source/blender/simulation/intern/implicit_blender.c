@@ -1741,7 +1741,7 @@ BLI_INLINE float fbstar_jacobi(float length, float L, float kb, float cb)
 }
 
 /* calculate elongation */
-BLI_INLINE bool spring_length(Implicit_Data *data,
+BLI_INLINE bool spring_length(const Implicit_Data *data,
                               int i,
                               int j,
                               float r_extent[3],
@@ -1773,41 +1773,39 @@ BLI_INLINE bool spring_length(Implicit_Data *data,
   return true;
 }
 
-BLI_INLINE void apply_spring(Implicit_Data *data,
-                             int i,
-                             int j,
-                             const float f[3],
-                             const float dfdx[3][3],
-                             const float dfdv[3][3])
+void SIM_mass_spring_apply_spring_force(Implicit_Data *data,
+                                        int i,
+                                        int j,
+                                        const ImplicitSpringForce *force)
 {
   int block_ij = SIM_mass_spring_add_block(data, i, j);
 
-  add_v3_v3(data->F[i], f);
-  sub_v3_v3(data->F[j], f);
+  add_v3_v3(data->F[i], force->f);
+  sub_v3_v3(data->F[j], force->f);
 
-  add_m3_m3m3(data->dFdX[i].m, data->dFdX[i].m, dfdx);
-  add_m3_m3m3(data->dFdX[j].m, data->dFdX[j].m, dfdx);
-  sub_m3_m3m3(data->dFdX[block_ij].m, data->dFdX[block_ij].m, dfdx);
+  add_m3_m3m3(data->dFdX[i].m, data->dFdX[i].m, force->dfdx);
+  add_m3_m3m3(data->dFdX[j].m, data->dFdX[j].m, force->dfdx);
+  sub_m3_m3m3(data->dFdX[block_ij].m, data->dFdX[block_ij].m, force->dfdx);
 
-  add_m3_m3m3(data->dFdV[i].m, data->dFdV[i].m, dfdv);
-  add_m3_m3m3(data->dFdV[j].m, data->dFdV[j].m, dfdv);
-  sub_m3_m3m3(data->dFdV[block_ij].m, data->dFdV[block_ij].m, dfdv);
+  add_m3_m3m3(data->dFdV[i].m, data->dFdV[i].m, force->dfdv);
+  add_m3_m3m3(data->dFdV[j].m, data->dFdV[j].m, force->dfdv);
+  sub_m3_m3m3(data->dFdV[block_ij].m, data->dFdV[block_ij].m, force->dfdv);
 }
 
-bool SIM_mass_spring_force_spring_linear(Implicit_Data *data,
-                                         int i,
-                                         int j,
-                                         float restlen,
-                                         float stiffness_tension,
-                                         float damping_tension,
-                                         float stiffness_compression,
-                                         float damping_compression,
-                                         bool resist_compress,
-                                         bool new_compress,
-                                         float clamp_force)
+bool SIM_mass_spring_eval_spring_linear(const Implicit_Data *data,
+                                        int i,
+                                        int j,
+                                        float restlen,
+                                        float stiffness_tension,
+                                        float damping_tension,
+                                        float stiffness_compression,
+                                        float damping_compression,
+                                        bool resist_compress,
+                                        bool new_compress,
+                                        float clamp_force,
+                                        ImplicitSpringForce *r_force)
 {
   float extent[3], length, dir[3], vel[3];
-  float f[3], dfdx[3][3], dfdv[3][3];
   float damping = 0;
 
   /* calculate elongation */
@@ -1825,9 +1823,9 @@ bool SIM_mass_spring_force_spring_linear(Implicit_Data *data,
     if (clamp_force > 0.0f && stretch_force > clamp_force) {
       stretch_force = clamp_force;
     }
-    mul_v3_v3fl(f, dir, stretch_force);
+    mul_v3_v3fl(r_force->f, dir, stretch_force);
 
-    dfdx_spring(dfdx, dir, length, restlen, stiffness_tension);
+    dfdx_spring(r_force->dfdx, dir, length, restlen, stiffness_tension);
   }
   else if (new_compress) {
     /* This is based on the Choi and Ko bending model,
@@ -1837,26 +1835,63 @@ bool SIM_mass_spring_force_spring_linear(Implicit_Data *data,
 
     damping = damping_compression;
 
-    mul_v3_v3fl(f, dir, fbstar(length, restlen, kb, cb));
+    mul_v3_v3fl(r_force->f, dir, fbstar(length, restlen, kb, cb));
 
-    outerproduct(dfdx, dir, dir);
-    mul_m3_fl(dfdx, fbstar_jacobi(length, restlen, kb, cb));
+    outerproduct(r_force->dfdx, dir, dir);
+    mul_m3_fl(r_force->dfdx, fbstar_jacobi(length, restlen, kb, cb));
   }
   else {
     return false;
   }
 
-  madd_v3_v3fl(f, dir, damping * dot_v3v3(vel, dir));
-  dfdv_damp(dfdv, dir, damping);
+  madd_v3_v3fl(r_force->f, dir, damping * dot_v3v3(vel, dir));
+  dfdv_damp(r_force->dfdv, dir, damping);
+
+  return true;
+}
+
+bool SIM_mass_spring_force_spring_linear(Implicit_Data *data,
+                                         int i,
+                                         int j,
+                                         float restlen,
+                                         float stiffness_tension,
+                                         float damping_tension,
+                                         float stiffness_compression,
+                                         float damping_compression,
+                                         bool resist_compress,
+                                         bool new_compress,
+                                         float clamp_force)
+{
+  ImplicitSpringForce force;
+
+  if (!SIM_mass_spring_eval_spring_linear(data,
+                                          i,
+                                          j,
+                                          restlen,
+                                          stiffness_tension,
+                                          damping_tension,
+                                          stiffness_compression,
+                                          damping_compression,
+                                          resist_compress,
+                                          new_compress,
+                                          clamp_force,
+                                          &force)) {
+    return false;
+  }
 
-  apply_spring(data, i, j, f, dfdx, dfdv);
+  SIM_mass_spring_apply_spring_force(data, i, j, &force);
 
   return true;
 }
 
 /* See "Stable but Responsive Cloth" (Choi, Ko 2005) */
-bool SIM_mass_spring_force_spring_bending(
-    Implicit_Data *data, int i, int j, float restlen, float kb, float cb)
+bool SIM_mass_spring_eval_spring_bending(const Implicit_Data *data,
+                                         int i,
+                                         int j,
+                                         float restlen,
+                                         float kb,
+                                         float cb,
+                                         ImplicitSpringForce *r_force)
 {
   float extent[3], length, dir[3], vel[3];
 
@@ -1864,17 +1899,13 @@ bool SIM_mass_spring_force_spring_bending(
   spring_length(data, i, j, extent, dir, &length, vel);
 
   if (length < restlen) {
-    float f[3], dfdx[3][3], dfdv[3][3];
-
-    mul_v3_v3fl(f, dir, fbstar(length, restlen, kb, cb));
+    mul_v3_v3fl(r_force->f, dir, fbstar(length, restlen, kb, cb));
 
-    outerproduct(dfdx, dir, dir);
-    mul_m3_fl(dfdx, fbstar_jacobi(length, restlen, kb, cb));
+    outerproduct(r_force->dfdx, dir, dir);
+    mul_m3_fl(r_force->dfdx, fbstar_jacobi(length, restlen, kb, cb));
 
     /* XXX damping not supported */
-    zero_m3(dfdv);
-
-    apply_spring(data, i, j, f, dfdx, dfdv);
+    zero_m3(r_force->dfdv);
 
     return true;
   }
@@ -1882,6 +1913,20 @@ bool SIM_mass_spring_force_spring_bending(
   return false;
 }
 
+bool SIM_mass_spring_force_spring_bending(
+    Implicit_Data *data, int i, int j, float restlen, float kb, float cb)
+{
+  ImplicitSpringForce force;
+
+  if (!SIM_mass_spring_eval_spring_bending(data, i, j, restlen, kb, cb, &force)) {
+    return false;
+  }
+
+  SIM_mass_spring_apply_spring_force(data, i, j, &force);
+
+  return true;
+}
+
 BLI_INLINE void poly_avg(lfVector *data, const int *inds, int len, float r_avg[3])
 {
   float fact = 1.0f / (float)len;
@@ -1928,7 +1973,7 @@ BLI_INLINE float bend_angle(const float dir_a[3], const float dir_b[3], const fl
   return atan2f(sin, cos);
 }
 
-BLI_INLINE void spring_angle(Implicit_Data *data,
+BLI_INLINE void spring_angle(const Implicit_Data *data,
                              int i,
                              int j,
                              int *i_a,
@@ -1961,21 +2006,21 @@ BLI_INLINE void spring_angle(Implicit_Data *data,
 
 /* Angular springs roughly based on the bending model proposed by Baraff and Witkin in "Large Steps
  * in Cloth Simulation". */
-bool SIM_mass_spring_force_spring_angular(Implicit_Data *data,
-                                          int i,
-                                          int j,
-                                          int *i_a,
-                                          int *i_b,
-                                          int len_a,
-                                          int len_b,
-                                          float restang,
-                                          float stiffness,
-                                          float damping)
+bool SIM_mass_spring_eval_spring_angular(const Implicit_Data *data,
+                                         int i,
+                                         int j,
+                                         int *i_a,
+                                         int *i_b,
+                                         int len_a,
+                                         int len_b,
+                                         float restang,
+                                         float stiffness,
+                                         float damping,
+                                         ImplicitSpringForce *r_force)
 {
   float angle, dir_a[3], dir_b[3], vel_a[3], vel_b[3];
-  float f_a[3], f_b[3], f_e[3];
+  float f_a[3], f_b[3];
   float force;
-  int x;
 
   spring_angle(data, i, j, i_a, i_b, len_a, len_b, dir_a, dir_b, &angle, vel_a, vel_b);
 
@@ -1985,24 +2030,56 @@ bool SIM_mass_spring_force_spring_angular(Implicit_Data *data,
   /* damping force */
   force += -damping * (dot_v3v3(vel_a, dir_a) + dot_v3v3(vel_b, dir_b));
 
-  mul_v3_v3fl(f_a, dir_a, force / len_a);
-  mul_v3_v3fl(f_b, dir_b, force / len_b);
+  mul_v3_v3fl(r_force->f_a, dir_a, force / len_a);
+  mul_v3_v3fl(r_force->f_b, dir_b, force / len_b);
+
+  mul_v3_v3fl(f_a, dir_a, force * 0.5f);
+  mul_v3_v3fl(f_b, dir_b, force * 0.5f);
+
+  add_v3_v3v3(r_force->f, f_a, f_b);
+
+  return true;
+}
+
+void SIM_mass_spring_apply_spring_angular_force(Implicit_Data *data,
+                                                int i,
+                                                int j,
+                                                const int *i_a,
+                                                const int *i_b,
+                                                int len_a,
+                                                int len_b,
+                                                const ImplicitSpringForce *force)
+{
+  int x;
 
   for (x = 0; x < len_a; x++) {
-    add_v3_v3(data->F[i_a[x]], f_a);
+    add_v3_v3(data->F[i_a[x]], force->f_a);
   }
 
   for (x = 0; x < len_b; x++) {
-    add_v3_v3(data->F[i_b[x]], f_b);
+    add_v3_v3(data->F[i_b[x]], force->f_b);
   }
 
-  mul_v3_v3fl(f_a, dir_a, force * 0.5f);
-  mul_v3_v3fl(f_b, dir_b, force * 0.5f);
+  sub_v3_v3(data->F[i], force->f);
+  sub_v3_v3(data->F[j], force->f);
+}
 
-  add_v3_v3v3(f_e, f_a, f_b);
+bool SIM_mass_spring_force_spring_angular(Implicit_Data *data,
+                                          int i,
+                                          int j,
+                                          int *i_a,
+                                          int *i_b,
+                                          int len_a,
+                                          int len_b,
+                                          float restang,
+                                          float stiffness,
+                                          float damping)
+{
+  ImplicitSpringForce force;
 
-  sub_v3_v3(data->F[i], f_e);
-  sub_v3_v3(data->F[j], f_e);
+  SIM_mass_spring_eval_spring_angular(
+      data, i, j, i_a, i_b, len_a, len_b, restang, stiffness, damping, &force);
+  SIM_mass_spring_apply_spring_angular_force(data, i, j, i_a, i_b, len_a, len_b, &force);
 
   return true;
 }
@@ -611,6 +611,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
 
   printf("\n");
   BLI_argsPrintArgDoc(ba, "--debug-fpe");
+  BLI_argsPrintArgDoc(ba, "--memory-thread-cache");
   BLI_argsPrintArgDoc(ba, "--disable-crash-handler");
   BLI_argsPrintArgDoc(ba, "--disable-abort-handler");
 
@@ -1075,6 +1076,19 @@ static int arg_handle_debug_mode_memory_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_memory_thread_cache_set_doc[] =
+    "\n\t"
+    "Use per-thread caches for small memory allocations, "
+    "faster for heavily multi-threaded workloads but memory is returned to the system less "
+    "eagerly.";
+static int arg_handle_memory_thread_cache_set(int UNUSED(argc),
+                                              const char **UNUSED(argv),
+                                              void *UNUSED(data))
+{
+  /* Handled in `main()` before any allocation happened. */
+  return 0;
+}
+
 static const char arg_handle_debug_value_set_doc[] =
     "<value>\n"
     "\tSet debug value of <value> on startup.";
@@ -2154,6 +2168,8 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_argsAdd(ba, 1, NULL, "--debug-cycles", CB(arg_handle_debug_mode_cycles), NULL);
 #  endif
   BLI_argsAdd(ba, 1, NULL, "--debug-memory", CB(arg_handle_debug_mode_memory_set), NULL);
+  BLI_argsAdd(
+      ba, 1, NULL, "--memory-thread-cache", CB(arg_handle_memory_thread_cache_set), NULL);
 
   BLI_argsAdd(ba, 1, NULL, "--debug-value", CB(arg_handle_debug_value_set), NULL);
   BLI_argsAdd(ba,
@@ -0,0 +1,107 @@
+# Apache License, Version 2.0
+
+# ./blender.bin --background -noaudio --python tests/python/bl_pyapi_prop_collection_view.py -- --verbose
+import bpy
+import unittest
+import numpy as np
+
+
+class TestPropCollectionView(unittest.TestCase):
+    def setUp(self):
+        self.mesh = bpy.data.meshes.new("TestPropCollectionView")
+        self.mesh.vertices.add(8)
+        self.mesh.vertices.foreach_set("co", np.arange(8 * 3, dtype=np.float32))
+
+    def tearDown(self):
+        if self.mesh is not None:
+            bpy.data.meshes.remove(self.mesh)
+
+    def vertex_coords(self):
+        co = np.empty(len(self.mesh.vertices) * 3, dtype=np.float32)
+        self.mesh.vertices.foreach_get("co", co)
+        return co.reshape(-1, 3)
+
+    def test_read(self):
+        with memoryview(self.mesh.vertices.co_view) as m:
+            self.assertEqual(m.shape, (8, 3))
+            self.assertEqual(m.format, "f")
+            self.assertTrue(m.readonly)
+            np.testing.assert_array_equal(np.asarray(m), self.vertex_coords())
+
+    def test_write(self):
+        co = np.asarray(self.mesh.vertices.co_view)
+        self.assertTrue(co.flags.writeable)
+        co[2] = (-1.0, -2.0, -3.0)
+        # The buffer is not a copy, changes are visible immediately.
+        np.testing.assert_array_equal(self.vertex_coords()[2], (-1.0, -2.0, -3.0))
+        self.mesh.vertices.co_view.update()
+        del co
+
+    def test_pinned(self):
+        co = np.asarray(self.mesh.vertices.co_view)
+        with self.assertRaises(BufferError):
+            self.mesh.vertices.add(100)
+        with self.assertRaises(BufferError):
+            self.mesh.update()
+        with self.assertRaises(BufferError):
+            bpy.data.meshes.remove(self.mesh)
+        with self.assertRaises(BufferError):
+            bpy.data.batch_remove(ids=(self.mesh,))
+        with self.assertRaises(BufferError):
+            bpy.ops.mesh.primitive_cube_add()
+        self.assertEqual(len(self.mesh.vertices), 8)
+        del co
+
+        # Released buffers unpin the mesh.
+        self.mesh.vertices.add(100)
+        self.mesh.update()
+        with memoryview(self.mesh.vertices.co_view) as m:
+            self.assertEqual(m.shape, (108, 3))
+
+    def test_readonly_then_writable(self):
+        with memoryview(self.mesh.vertices.co_view) as m:
+            self.assertTrue(m.readonly)
+            with self.assertRaises(BufferError):
+                np.asarray(self.mesh.vertices.co_view)
+        co = np.asarray(self.mesh.vertices.co_view)
+        self.assertTrue(co.flags.writeable)
+        del co
+
+    def test_remove(self):
+        view = self.mesh.vertices.co_view
+        bpy.data.meshes.remove(self.mesh)
+        self.mesh = None
+        with self.assertRaises(ReferenceError):
+            memoryview(view)
+        with self.assertRaises(ReferenceError):
+            view.update()
+
+    def test_not_in_main(self):
+        ob = bpy.data.objects.new("TestPropCollectionView", self.mesh)
+        bpy.context.scene.collection.objects.link(ob)
+        try:
+            depsgraph = bpy.context.evaluated_depsgraph_get()
+            ob_eval = ob.evaluated_get(depsgraph)
+            with self.assertRaises(BufferError):
+                memoryview(ob_eval.data.vertices.co_view)
+            mesh_tmp = ob_eval.to_mesh()
+            with self.assertRaises(BufferError):
+                memoryview(mesh_tmp.vertices.co_view)
+            ob_eval.to_mesh_clear()
+        finally:
+            bpy.data.objects.remove(ob)
+
+    def test_update_empty(self):
+        mesh = bpy.data.meshes.new("TestPropCollectionViewEmpty")
+        try:
+            with memoryview(mesh.vertices.co_view) as m:
+                self.assertEqual(m.shape, (0, 3))
+            mesh.vertices.co_view.update()
+        finally:
+            bpy.data.meshes.remove(mesh)
+
+
+if __name__ == '__main__':
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()